@@ -1,10 +1,18 @@
 set(headers ${headers}
-	include/CLibUtilsQTR/utils.hpp
+	include/ClibUtilsQTR/utils.hpp
 	include/CLibUtilsQTR/Animations.hpp
 	include/CLibUtilsQTR/BoundingBox.hpp
 	include/CLibUtilsQTR/DrawDebug.hpp
+	include/CLibUtilsQTR/EditorIDIndex.hpp
+	include/CLibUtilsQTR/FormBatchConverter.hpp
+	include/CLibUtilsQTR/FormLiteral.hpp
 	include/CLibUtilsQTR/FormReader.hpp
+	include/CLibUtilsQTR/FormReaderCache.hpp
+	include/CLibUtilsQTR/MappedFile.hpp
 	include/CLibUtilsQTR/Papyrus.hpp
+	include/CLibUtilsQTR/Parallel.hpp
+	include/CLibUtilsQTR/PluginIndex.hpp
+	include/CLibUtilsQTR/PresetBlock.hpp
 	include/CLibUtilsQTR/PresetSettings.hpp
 	include/CLibUtilsQTR/Serialization.hpp
 	include/CLibUtilsQTR/StringHelpers.hpp
@@ -12,7 +20,20 @@ set(headers ${headers}
 	include/CLibUtilsQTR/Ticker.hpp
 	include/CLibUtilsQTR/PresetHelpers/Config.hpp
 	include/CLibUtilsQTR/PresetHelpers/Getters.hpp
+	include/CLibUtilsQTR/PresetHelpers/GettersYAML.hpp
+	include/CLibUtilsQTR/PresetHelpers/FormGroupExpressions.hpp
+	include/CLibUtilsQTR/PresetHelpers/FormGroupGraph.hpp
+	include/CLibUtilsQTR/PresetHelpers/FormGroupsCache.hpp
+	include/CLibUtilsQTR/PresetHelpers/FormGroupsReverseIndex.hpp
+	include/CLibUtilsQTR/PresetHelpers/FormGroupsSnapshot.hpp
+	include/CLibUtilsQTR/PresetHelpers/FormGroupsReloader.hpp
+	include/CLibUtilsQTR/PresetHelpers/FrozenFormGroups.hpp
+	include/CLibUtilsQTR/PresetHelpers/JSONLoadContext.hpp
+	include/CLibUtilsQTR/PresetHelpers/JSONLoader.hpp
+	include/CLibUtilsQTR/PresetHelpers/PresetCache.hpp
 	include/CLibUtilsQTR/PresetHelpers/PresetHelpers.hpp
 	include/CLibUtilsQTR/PresetHelpers/PresetHelpersTXT.hpp
+	include/CLibUtilsQTR/PresetHelpers/PresetPipeline.hpp
 	include/CLibUtilsQTR/PresetHelpers/PresetHelpersYAML.hpp
+	include/CLibUtilsQTR/PresetHelpers/Schema.hpp
 )
\ No newline at end of file
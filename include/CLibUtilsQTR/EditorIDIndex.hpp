@@ -0,0 +1,152 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ClibUtil/editorID.hpp"
+
+namespace FormReader {
+    using FormID = RE::FormID;
+
+    /**
+     * @brief Optional FormID -> EditorID reverse index for bulk exports and diagnostics.
+     *
+     * All EditorIDs live back to back in one string arena; ids is sorted and offsets[i]..offsets[i + 1]
+     * is the EditorID of ids[i].
+     *
+     * Build fills a new table and publishes it with one atomic store, so lookups may run on other threads while it
+     * rebuilds. Only the current arena and the one it replaced are kept: a returned string_view survives the next
+     * Build and dangles after the one following it, so copy results that must outlive a game load.
+     */
+    class EditorIDIndex {
+    public:
+        struct Record {
+            FormID id = 0;
+            std::string_view editor_id;
+        };
+
+        void Build(const std::span<const Record> a_records) {
+            std::vector<Record> sorted(a_records.begin(), a_records.end());
+            std::ranges::stable_sort(sorted, {}, &Record::id);
+
+            auto table = std::make_unique<Table>();
+            std::size_t total = 0;
+            for (const auto& record : sorted) total += record.editor_id.size();
+            table->arena.reserve(total);
+            table->ids.reserve(sorted.size());
+            table->offsets.reserve(sorted.size() + 1);
+
+            for (const auto& [id, editor_id] : sorted) {
+                if (editor_id.empty() || (!table->ids.empty() && table->ids.back() == id)) continue;
+                table->ids.push_back(id);
+                table->offsets.push_back(static_cast<std::uint32_t>(table->arena.size()));
+                table->arena.append(editor_id);
+            }
+            table->offsets.push_back(static_cast<std::uint32_t>(table->arena.size()));
+
+            std::lock_guard lock(build_mutex_);
+            retired_ = std::move(live_);
+            live_ = std::move(table);
+            table_.store(live_.get(), std::memory_order_release);
+        }
+
+        // Snapshot of every loaded form that has an EditorID. Call after kDataLoaded.
+        void BuildFromForms() {
+            std::vector<std::pair<FormID, std::string>> editor_ids;
+            {
+                const auto [map, lock] = RE::TESForm::GetAllForms();
+                RE::BSReadLockGuard locker{lock.get()};
+                if (!map) return;
+                editor_ids.reserve(map->size());
+                for (const auto& [id, form] : *map) {
+                    if (!form) continue;
+                    if (auto editor_id = clib_util::editorID::get_editorID(form); !editor_id.empty()) {
+                        editor_ids.emplace_back(id, std::move(editor_id));
+                    }
+                }
+            }
+
+            std::vector<Record> records;
+            records.reserve(editor_ids.size());
+            for (const auto& [id, editor_id] : editor_ids) records.push_back({id, editor_id});
+            Build(records);
+        }
+
+        [[nodiscard]] bool IsBuilt() const { return table_.load(std::memory_order_acquire) != nullptr; }
+
+        [[nodiscard]] std::size_t size() const {
+            const auto table = table_.load(std::memory_order_acquire);
+            return table ? table->ids.size() : 0;
+        }
+
+        // Empty view if the form is not indexed
+        [[nodiscard]] std::string_view Get(const FormID a_formid) const {
+            const auto table = table_.load(std::memory_order_acquire);
+            return table ? table->Get(a_formid) : std::string_view{};
+        }
+
+        // Batch query. Sorted input is answered with a single forward walk over the index.
+        void Get(const std::span<const FormID> a_formids, const std::span<std::string_view> a_out) const {
+            const auto count = std::min(a_formids.size(), a_out.size());
+            const auto table = table_.load(std::memory_order_acquire);
+            if (!table) {
+                std::ranges::fill(a_out.first(count), std::string_view{});
+                return;
+            }
+            if (!std::ranges::is_sorted(a_formids.first(count))) {
+                for (std::size_t i = 0; i < count; ++i) a_out[i] = table->Get(a_formids[i]);
+                return;
+            }
+
+            const auto& ids = table->ids;
+            auto it = ids.begin();
+            for (std::size_t i = 0; i < count; ++i) {
+                it = std::lower_bound(it, ids.end(), a_formids[i]);
+                a_out[i] = it != ids.end() && *it == a_formids[i] ? table->At(static_cast<std::size_t>(it - ids.begin()))
+                                                                  : std::string_view{};
+            }
+        }
+
+        [[nodiscard]] std::vector<std::string_view> Get(const std::span<const FormID> a_formids) const {
+            std::vector<std::string_view> result(a_formids.size());
+            Get(a_formids, result);
+            return result;
+        }
+
+        // Linear scan in FormID order, e.g. for exporting everything
+        template <typename Func>
+        void ForEach(Func&& a_func) const {
+            const auto table = table_.load(std::memory_order_acquire);
+            if (!table) return;
+            for (std::size_t i = 0; i < table->ids.size(); ++i) a_func(table->ids[i], table->At(i));
+        }
+
+    private:
+        struct Table {
+            std::vector<FormID> ids;
+            std::vector<std::uint32_t> offsets;
+            std::string arena;
+
+            [[nodiscard]] std::string_view At(const std::size_t a_index) const {
+                return std::string_view(arena).substr(offsets[a_index], offsets[a_index + 1] - offsets[a_index]);
+            }
+
+            [[nodiscard]] std::string_view Get(const FormID a_formid) const {
+                const auto it = std::ranges::lower_bound(ids, a_formid);
+                if (it == ids.end() || *it != a_formid) return {};
+                return At(static_cast<std::size_t>(it - ids.begin()));
+            }
+        };
+
+        std::atomic<const Table*> table_{nullptr};
+        std::unique_ptr<const Table> live_;
+        std::unique_ptr<const Table> retired_;  // arena of the previous Build, still referenced by recent views
+        std::mutex build_mutex_;
+    };
+
+    inline EditorIDIndex editorIDIndex;
+}
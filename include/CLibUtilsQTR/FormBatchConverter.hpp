@@ -0,0 +1,155 @@
+#pragma once
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CLibUtilsQTR/FormReader.hpp"
+#include "CLibUtilsQTR/Parallel.hpp"
+
+namespace FormReader {
+    struct BatchOptions {
+        std::size_t chunk_size = 8 << 20;  // bytes read from the input per round
+        std::size_t threads = 0;           // 0 = clib_utilsQTR::DefaultThreadCount()
+        bool keep_invalid = false;         // copy lines that fail conversion unchanged instead of dropping them
+    };
+
+    struct BatchStats {
+        std::size_t lines = 0;
+        std::size_t converted = 0;
+        std::size_t errors = 0;
+        double seconds = 0.0;
+
+        [[nodiscard]] double LinesPerSecond() const { return seconds > 0.0 ? static_cast<double>(lines) / seconds : 0.0; }
+
+        BatchStats& operator+=(const BatchStats& a_other) {
+            lines += a_other.lines;
+            converted += a_other.converted;
+            errors += a_other.errors;
+            return *this;
+        }
+    };
+
+    namespace detail {
+        // Converts whole lines of a_text into a_out, one output line per converted input line
+        inline BatchStats ConvertLines(std::string_view a_text, const std::string_view a_plugin, std::string& a_out,
+                                       const bool a_keep_invalid) {
+            BatchStats stats;
+            a_out.reserve(a_out.size() + a_text.size() + a_text.size() / 8 * a_plugin.size());
+            auto out = std::back_inserter(a_out);
+
+            while (!a_text.empty()) {
+                const auto eol = a_text.find('\n');
+                const auto line = a_text.substr(0, eol);
+                a_text.remove_prefix(eol == std::string_view::npos ? a_text.size() : eol + 1);
+
+                const auto outcome = processInput(line, a_plugin, out);
+                if (outcome.error == ProcessError::kEmptyInput) continue;
+
+                ++stats.lines;
+                if (outcome.error == ProcessError::kNone) {
+                    ++stats.converted;
+                    a_out.push_back('\n');
+                } else {
+                    ++stats.errors;
+                    if (a_keep_invalid) {
+                        a_out.append(line);
+                        a_out.push_back('\n');
+                    }
+                }
+            }
+            return stats;
+        }
+
+        // Splits a_text into at most a_parts pieces, each ending on a line boundary
+        inline std::vector<std::string_view> SplitAtLines(const std::string_view a_text, const std::size_t a_parts) {
+            std::vector<std::string_view> parts;
+            const auto target = std::max<std::size_t>(1, a_text.size() / std::max<std::size_t>(1, a_parts));
+            std::size_t begin = 0;
+            while (begin < a_text.size()) {
+                auto end = std::min(begin + target, a_text.size());
+                if (end < a_text.size()) {
+                    const auto eol = a_text.find('\n', end);
+                    end = eol == std::string_view::npos ? a_text.size() : eol + 1;
+                }
+                parts.push_back(a_text.substr(begin, end - begin));
+                begin = end;
+            }
+            return parts;
+        }
+    }
+
+    /**
+     * @brief Converts newline separated raw xEdit ids (see processInput) in parallel, keeping the input order.
+     *
+     * @param a_sink Callable taking `std::string_view`; receives the converted text in order, in large pieces.
+     */
+    template <typename Sink>
+    BatchStats ConvertBuffer(const std::string_view a_input, const std::string_view a_plugin, Sink&& a_sink,
+                             const BatchOptions& a_options = {}) {
+        const auto threads = a_options.threads ? a_options.threads : clib_utilsQTR::DefaultThreadCount();
+        const auto parts = detail::SplitAtLines(a_input, threads);
+
+        std::vector<std::string> outputs(parts.size());
+        std::vector<BatchStats> part_stats(parts.size());
+        clib_utilsQTR::ParallelFor(parts.size(), [&](const std::size_t i) {
+            part_stats[i] = detail::ConvertLines(parts[i], a_plugin, outputs[i], a_options.keep_invalid);
+        }, threads);
+
+        BatchStats stats;
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            stats += part_stats[i];
+            if (!outputs[i].empty()) a_sink(std::string_view(outputs[i]));
+        }
+        return stats;
+    }
+
+    /**
+     * @brief Streaming file to file version of ConvertBuffer.
+     *
+     * Reads `chunk_size` bytes at a time, carries the trailing partial line over to the next chunk and writes
+     * every converted chunk through one output stream. Returns the counts and the wall time of the whole run.
+     */
+    inline BatchStats ConvertFile(const std::filesystem::path& a_input, const std::filesystem::path& a_output,
+                                  const std::string_view a_plugin, const BatchOptions& a_options = {}) {
+        const auto start = std::chrono::steady_clock::now();
+        BatchStats stats;
+
+        std::ifstream in(a_input, std::ios::binary);
+        std::ofstream out(a_output, std::ios::binary | std::ios::trunc);
+        if (!in.is_open() || !out.is_open()) {
+            return stats;
+        }
+
+        const auto sink = [&out](const std::string_view a_text) {
+            out.write(a_text.data(), static_cast<std::streamsize>(a_text.size()));
+        };
+
+        const auto chunk_size = std::max<std::size_t>(a_options.chunk_size, 4096);
+        std::string buffer;
+        std::size_t carry = 0;
+        while (in) {
+            buffer.resize(carry + chunk_size);
+            in.read(buffer.data() + carry, static_cast<std::streamsize>(chunk_size));
+            const auto filled = carry + static_cast<std::size_t>(in.gcount());
+            if (filled == 0) break;
+
+            // Only convert up to the last complete line unless this was the final read
+            auto usable = filled;
+            if (in) {
+                const auto eol = std::string_view(buffer.data(), filled).rfind('\n');
+                usable = eol == std::string_view::npos ? 0 : eol + 1;
+            }
+
+            stats += ConvertBuffer(std::string_view(buffer.data(), usable), a_plugin, sink, a_options);
+
+            carry = filled - usable;
+            std::memmove(buffer.data(), buffer.data() + usable, carry);
+        }
+
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <algorithm>
+#include <string_view>
+#include "CLibUtilsQTR/PluginIndex.hpp"
+#include "CLibUtilsQTR/StringHelpers.hpp"
+
+namespace FormReader {
+    /**
+     * @brief Form identifier parsed at compile time.
+     *
+     * `LocalID~Plugin` keeps the local id, the plugin name and its StringHelpers::fnv1a_ci key so that
+     * the runtime part is only the final load-order lookup. A plain 7-8 digit hex FormID leaves plugin empty.
+     */
+    struct FormDescriptor {
+        std::uint32_t localID = 0;
+        std::string_view plugin;
+        std::uint64_t pluginKey = 0;
+
+        [[nodiscard]] constexpr bool HasPlugin() const { return !plugin.empty(); }
+
+        // 0 if the plugin is not loaded
+        [[nodiscard]] FormID Resolve() const {
+            if (!HasPlugin()) return localID;
+            if (pluginIndex.IsBuilt()) {
+                if (const auto entry = pluginIndex.Find(pluginKey, plugin)) {
+                    return PluginIndex::Compose(*entry, localID);
+                }
+                return 0;
+            }
+            return RE::TESDataHandler::GetSingleton()->LookupFormID(localID, plugin);
+        }
+
+        template <typename T = RE::TESForm>
+        [[nodiscard]] T* Lookup() const {
+            if (const auto formid = Resolve(); formid > 0) {
+                if constexpr (std::is_same_v<T, RE::TESForm>) {
+                    return RE::TESForm::LookupByID(formid);
+                } else {
+                    return RE::TESForm::LookupByID<T>(formid);
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    namespace detail {
+        // Not constexpr on purpose: reaching it during constant evaluation turns a bad identifier into a build error
+        inline void malformed_form_identifier(const char*) {
+        }
+
+        consteval std::uint32_t ParseHexID(std::string_view a_hex, const std::size_t a_minDigits) {
+            if (a_hex.starts_with("0x") || a_hex.starts_with("0X")) a_hex.remove_prefix(2);
+            if (a_hex.size() < a_minDigits || a_hex.size() > 8) {
+                malformed_form_identifier("hex id has the wrong number of digits");
+            }
+
+            std::uint32_t value = 0;
+            for (const char c : a_hex) {
+                value <<= 4;
+                if (c >= '0' && c <= '9') {
+                    value |= static_cast<std::uint32_t>(c - '0');
+                } else if (c >= 'a' && c <= 'f') {
+                    value |= static_cast<std::uint32_t>(c - 'a' + 10);
+                } else if (c >= 'A' && c <= 'F') {
+                    value |= static_cast<std::uint32_t>(c - 'A' + 10);
+                } else {
+                    malformed_form_identifier("hex id contains a non-hex character");
+                }
+            }
+            return value;
+        }
+
+        consteval bool IsPluginFilename(const std::string_view a_plugin) {
+            if (a_plugin.size() <= 4) return false;
+            const auto extension = a_plugin.substr(a_plugin.size() - 4);
+            return StringHelpers::iequals(extension, ".esp") || StringHelpers::iequals(extension, ".esm") ||
+                   StringHelpers::iequals(extension, ".esl");
+        }
+
+        template <std::size_t N>
+        struct FixedString {
+            char data[N]{};
+
+            // ReSharper disable once CppNonExplicitConvertingConstructor
+            consteval FixedString(const char (&a_str)[N]) { std::copy_n(a_str, N, data); }
+
+            [[nodiscard]] constexpr std::string_view view() const { return {data, N - 1}; }
+        };
+    }
+
+    // Accepts `LocalID~Plugin` or a 7-8 digit hex FormID, both with optional 0x. EditorIDs need the runtime lookup.
+    consteval FormDescriptor ParseFormIdentifier(const std::string_view a_identifier) {
+        FormDescriptor descriptor;
+        if (const auto tilde = a_identifier.find('~'); tilde != std::string_view::npos) {
+            descriptor.plugin = a_identifier.substr(tilde + 1);
+            if (!detail::IsPluginFilename(descriptor.plugin)) {
+                detail::malformed_form_identifier("plugin must be a .esp, .esm or .esl filename");
+            }
+            descriptor.localID = detail::ParseHexID(a_identifier.substr(0, tilde), 1);
+            descriptor.pluginKey = StringHelpers::fnv1a_ci(descriptor.plugin);
+        } else {
+            descriptor.localID = detail::ParseHexID(a_identifier, 7);
+        }
+        return descriptor;
+    }
+
+    namespace literals {
+        // "012345~Skyrim.esm"_form
+        template <detail::FixedString S>
+        consteval FormDescriptor operator""_form() {
+            return ParseFormIdentifier(S.view());
+        }
+    }
+}
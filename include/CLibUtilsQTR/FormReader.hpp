@@ -4,10 +4,14 @@
 #include <vector>
 #include <regex>
 #include <algorithm>
+#include <charconv>
 #include <cctype>
 #include <ios>
 #include <sstream>
 #include "ClibUtil/editorID.hpp"
+#include "CLibUtilsQTR/EditorIDIndex.hpp"
+#include "CLibUtilsQTR/PluginIndex.hpp"
+#include "CLibUtilsQTR/StringHelpers.hpp"
 
 namespace FormReader {
     using FormID = RE::FormID;
@@ -41,65 +45,88 @@ namespace FormReader {
         bool isMod;
     };
 
+    enum class ProcessError : std::uint8_t {
+        kNone,
+        kEmptyInput,
+        kInvalidLength,
+        kModNameRequired
+    };
+
+    inline std::string_view ProcessErrorMessage(const ProcessError a_error) {
+        switch (a_error) {
+            case ProcessError::kInvalidLength:
+                return "input must be 8 characters long";
+            case ProcessError::kModNameRequired:
+                return "Mod name required for non base game files";
+            default:
+                return "";
+        }
+    }
+
+    template <typename OutputIt>
+    struct ProcessOutcome {
+        ProcessError error;
+        bool isMod;
+        OutputIt out;
+    };
+
+    /**
+     * @brief Allocation-free processInput: converts a raw 8-digit FormID into `0xLOCAL~Plugin` notation.
+     *
+     * Output is only written on success, at most `9 + name.size()` characters (plugin name is trimmed).
+     * @return The error code, whether the id belongs to a mod, and the advanced output iterator.
+     */
+    template <std::output_iterator<char> OutputIt>
+    ProcessOutcome<OutputIt> processInput(const std::string_view input, std::string_view name, OutputIt out) {
+        if (input.empty()) return {ProcessError::kEmptyInput, true, out};
+
+        // Same cleaning as clean(): keep alphanumerics, uppercase
+        char digits[8];
+        std::size_t count = 0;
+        for (const char c : input) {
+            if (!std::isalnum(static_cast<unsigned char>(c))) continue;
+            if (count == 8) return {ProcessError::kInvalidLength, true, out};
+            digits[count++] = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        if (count != 8) return {ProcessError::kInvalidLength, true, out};
+
+        constexpr std::string_view whitespace = " \t\n\r\f\v";
+        if (const auto start = name.find_first_not_of(whitespace); start == std::string_view::npos) {
+            name = {};
+        } else {
+            name = name.substr(start, name.find_last_not_of(whitespace) - start + 1);
+        }
+
+        const std::string_view firstTwoDigits(digits, 2);
+        const bool esl = firstTwoDigits == "FE";
+        const bool mod = esl || std::ranges::find(masters, firstTwoDigits) == masters.end();
+
+        if (mod && name.empty()) return {ProcessError::kModNameRequired, mod, out};
+
+        std::string_view local(digits, 8);
+        if (mod) local.remove_prefix(esl ? 5 : 2);
+        local.remove_prefix(std::min(local.find_first_not_of('0'), local.size()));
+
+        *out++ = '0';
+        *out++ = 'x';
+        out = std::ranges::copy(local, out).out;
+        if (mod) {
+            *out++ = '~';
+            out = std::ranges::copy(name, out).out;
+        }
+        return {ProcessError::kNone, mod, out};
+    }
+
     // Function to process the input and produce the output
     inline Result processInput(const std::string& input, const std::string& name) {
         Result res;
         res.output = "";
-        res.error = true;
-        res.isMod = true;
-
-        if (!input.empty()) {
-            std::string result = clean(input);
-            std::string modName = name;
-
-            // Trim modName
-            modName.erase(modName.begin(), std::find_if(modName.begin(), modName.end(), [](const unsigned char ch) {
-                return !std::isspace(ch);
-            }));
-            modName.erase(std::find_if(modName.rbegin(), modName.rend(), [](const unsigned char ch) {
-                return !std::isspace(ch);
-            }).base(), modName.end());
-
-            if (result.length() != 8) {
-                res.output += "input must be 8 characters long";
-            }
 
-            if (res.output.empty()) {
-                res.error = false;
-
-                std::string firstTwoDigits = result.substr(0, 2);
-
-                bool esl = false;
-                bool mod = true;
-
-                if (firstTwoDigits == "FE") {
-                    esl = true;
-                } else if (std::ranges::find(masters, firstTwoDigits) != masters.end()) {
-                    mod = false;
-                }
-
-                res.isMod = mod;
-
-                if (mod) {
-                    if (esl) {
-                        result = result.substr(5);
-                    } else {
-                        result = result.substr(2);
-                    }
-                }
-
-                if (mod && modName.empty()) {
-                    res.error = true;
-                    res.output = "Mod name required for non base game files";
-                } else {
-                    size_t i = 0;
-                    while (i < result.length() && result[i] == '0') {
-                        i++;
-                    }
-
-                    res.output = "0x" + result.substr(i) + (mod ? ("~" + name) : "");
-                }
-            }
+        const auto outcome = processInput(std::string_view(input), name, std::back_inserter(res.output));
+        res.error = outcome.error != ProcessError::kNone;
+        res.isMod = outcome.isMod;
+        if (res.error) {
+            res.output = ProcessErrorMessage(outcome.error);
         }
 
         return res;
@@ -113,36 +140,41 @@ namespace FormReader {
     }
 
 
-    inline FormID GetForm(const char* fileName, const uint32_t localId) {
+    inline FormID GetForm(const std::string_view fileName, const uint32_t localId) {
+        if (pluginIndex.IsBuilt()) {
+            return pluginIndex.Resolve(localId, fileName);
+        }
         const auto dataHandler = RE::TESDataHandler::GetSingleton();
         const auto formId = dataHandler->LookupFormID(localId, fileName);
         return formId;
     }
 
-    inline FormID GetFormIDFromString(const std::string& input) {
-        FormID form_id_;
-        std::stringstream ss;
-        ss << std::hex << input;
-        ss >> form_id_;
+    // Hex with optional 0x prefix; 0 if it does not start with a hex number
+    inline FormID GetFormIDFromString(const std::string_view input) {
+        auto hex = StringHelpers::trim_view(input);
+        if (hex.starts_with("0x") || hex.starts_with("0X")) hex.remove_prefix(2);
+        FormID form_id_ = 0;
+        if (std::from_chars(hex.data(), hex.data() + hex.size(), form_id_, 16).ec != std::errc{}) {
+            return 0;
+        }
         return form_id_;
     }
 
-    inline bool isValidHexWithLength7or8(const char* input) {
-        std::string inputStr(input);
-
-        if (inputStr.substr(0, 2) == "0x") {
+    inline bool isValidHexWithLength7or8(std::string_view input) {
+        if (input.starts_with("0x")) {
             // Remove "0x" from the beginning of the string
-            inputStr = inputStr.substr(2);
+            input.remove_prefix(2);
         }
 
-        const std::regex hexRegex("^[0-9A-Fa-f]{7,8}$"); // Allow 7 to 8 characters
-        const bool isValid = std::regex_match(inputStr, hexRegex);
-        return isValid;
+        // Allow 7 to 8 characters
+        return (input.size() == 7 || input.size() == 8) &&
+               std::ranges::all_of(input, [](const unsigned char c) { return std::isxdigit(c) != 0; });
     }
 
-    inline RE::TESForm* GetFormByID(const RE::FormID id, const std::string& editor_id = "") {
+    // editor_id may be any view: LookupByEditorID reads its key as a C string, so it gets a terminated copy
+    inline RE::TESForm* GetFormByID(const RE::FormID id, const std::string_view editor_id = {}) {
         if (!editor_id.empty()) {
-            if (auto* form = RE::TESForm::LookupByEditorID(editor_id)) return form;
+            if (auto* form = RE::TESForm::LookupByEditorID(std::string(editor_id))) return form;
         }
         if (id > 0) {
             if (const auto form = RE::TESForm::LookupByID(id)) return form;
@@ -151,9 +183,9 @@ namespace FormReader {
     }
 
     template <typename T>
-    T* GetFormByID(const RE::FormID id, const std::string& editor_id = "") {
+    T* GetFormByID(const RE::FormID id, const std::string_view editor_id = {}) {
         if (!editor_id.empty()) {
-            if (auto* form = RE::TESForm::LookupByEditorID<T>(editor_id)) return form;
+            if (auto* form = RE::TESForm::LookupByEditorID<T>(std::string(editor_id))) return form;
         }
         if (id > 0) {
             if (const auto form = RE::TESForm::LookupByID<T>(id)) return form;
@@ -161,19 +193,19 @@ namespace FormReader {
         return nullptr;
     }
 
-    inline RE::TESForm* GetFormFromString(const std::string& formEditorId) {
+    // Works on views throughout; only an EditorID lookup copies the key (see GetFormByID)
+    inline RE::TESForm* GetFormFromString(const std::string_view formEditorId) {
         if (formEditorId.empty()) return nullptr;
 
-        static std::string delimiter = "~";
-        const auto plugin_and_localid = split(formEditorId, delimiter);
-        if (plugin_and_localid.size() == 2) {
-            const auto& plugin_name = plugin_and_localid[1];
-            const auto local_id = FormReader::GetFormIDFromString(plugin_and_localid[0]);
-            const auto formid = FormReader::GetForm(plugin_name.c_str(), local_id);
+        if (const auto tilde = formEditorId.find('~');
+            tilde != std::string_view::npos && formEditorId.find('~', tilde + 1) == std::string_view::npos) {
+            const auto plugin_name = formEditorId.substr(tilde + 1);
+            const auto local_id = FormReader::GetFormIDFromString(formEditorId.substr(0, tilde));
+            const auto formid = FormReader::GetForm(plugin_name, local_id);
             if (const auto form = RE::TESForm::LookupByID(formid)) return form;
         }
 
-        if (isValidHexWithLength7or8(formEditorId.c_str())) {
+        if (isValidHexWithLength7or8(formEditorId)) {
             if (const auto temp_form = GetFormByID(FormReader::GetFormIDFromString(formEditorId)))
                 return temp_form;
         }
@@ -183,16 +215,21 @@ namespace FormReader {
         return nullptr;
     }
 
-    inline FormID GetFormEditorIDFromString(const std::string& formEditorId) {
-        if (auto a_form = GetFormFromString(formEditorId)) {
-            return a_form->formID;
+    inline FormID GetFormEditorIDFromString(const std::string_view formEditorId) {
+        if (auto form = GetFormFromString(formEditorId)) {
+            return form->formID;
         }
         return 0;
     }
 
     inline std::string GetEditorID(FormID a_formid) {
-        if (auto a_form = GetFormByID(a_formid)) {
-            return clib_util::editorID::get_editorID(a_form);
+        if (editorIDIndex.IsBuilt()) {
+            if (const auto editor_id = editorIDIndex.Get(a_formid); !editor_id.empty()) {
+                return std::string(editor_id);
+            }
+        }
+        if (auto form = GetFormByID(a_formid)) {
+            return clib_util::editorID::get_editorID(form);
         }
         return "";
     }
@@ -0,0 +1,125 @@
+#pragma once
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "CLibUtilsQTR/FormReader.hpp"
+
+namespace FormReader {
+    // Transparent hash so the cache can be queried with a string_view without building a std::string
+    struct StringHash {
+        using is_transparent = void;
+
+        std::size_t operator()(const std::string_view a_str) const noexcept {
+            return std::hash<std::string_view>{}(a_str);
+        }
+    };
+
+    // Default lookup backend: the regular LocalID~Plugin / hex / EditorID chain
+    struct GameResolver {
+        FormID operator()(const std::string_view a_identifier) const {
+            return GetFormEditorIDFromString(a_identifier);
+        }
+    };
+
+    struct CacheStats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::size_t size = 0;
+    };
+
+    /**
+     * @brief Opt-in memoizing front end for identifier -> FormID resolution.
+     *
+     * Keys are the identifier with surrounding whitespace trimmed. Failed lookups are cached as 0 as well,
+     * so an unknown identifier only hits the backend once until the cache is invalidated. A lookup that
+     * was started before an Invalidate() still returns its result but does not store it.
+     *
+     * @tparam Resolver Callable `FormID(std::string_view)` doing the actual lookup. Swap it for a stand-in
+     *                  to use the cache outside of the game.
+     */
+    template <typename Resolver = GameResolver>
+    class ResolutionCache {
+    public:
+        ResolutionCache() = default;
+
+        explicit ResolutionCache(Resolver a_resolver) : resolver_(std::move(a_resolver)) {
+        }
+
+        FormID Resolve(const std::string_view a_identifier) {
+            const auto key = Normalize(a_identifier);
+            if (key.empty()) return 0;
+
+            {
+                std::shared_lock lock(mutex_);
+                if (const auto it = cache_.find(key); it != cache_.end()) {
+                    hits_.fetch_add(1, std::memory_order_relaxed);
+                    return it->second;
+                }
+            }
+
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            const auto generation = generation_.load(std::memory_order_acquire);
+            const FormID formid = resolver_(key);
+
+            std::unique_lock lock(mutex_);
+            if (generation == generation_.load(std::memory_order_relaxed)) {
+                cache_.try_emplace(std::string(key), formid);
+            }
+            return formid;
+        }
+
+        // Drops every cached entry. Counters are kept; see ResetStats.
+        void Invalidate() {
+            std::unique_lock lock(mutex_);
+            generation_.fetch_add(1, std::memory_order_release);
+            cache_.clear();
+        }
+
+        // Call from the plugin's SKSE message listener. Form lookups are only meaningful after data load
+        // and runtime forms change with every loaded save, so those events invalidate the cache.
+        void HandleMessage(const SKSE::MessagingInterface::Message* a_msg) {
+            if (!a_msg) return;
+            switch (a_msg->type) {
+                case SKSE::MessagingInterface::kDataLoaded:
+                case SKSE::MessagingInterface::kPreLoadGame:
+                case SKSE::MessagingInterface::kNewGame:
+                    Invalidate();
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        [[nodiscard]] CacheStats Stats() const {
+            CacheStats stats;
+            stats.hits = hits_.load(std::memory_order_relaxed);
+            stats.misses = misses_.load(std::memory_order_relaxed);
+            std::shared_lock lock(mutex_);
+            stats.size = cache_.size();
+            return stats;
+        }
+
+        void ResetStats() {
+            hits_.store(0, std::memory_order_relaxed);
+            misses_.store(0, std::memory_order_relaxed);
+        }
+
+        static std::string_view Normalize(const std::string_view a_identifier) {
+            return StringHelpers::trim_view(a_identifier);
+        }
+
+    private:
+        Resolver resolver_{};
+        std::unordered_map<std::string, FormID, StringHash, std::equal_to<>> cache_;
+        mutable std::shared_mutex mutex_;
+        // Bumped by Invalidate under mutex_; a lookup only stores its result if no invalidation happened meanwhile
+        std::atomic<std::uint64_t> generation_{0};
+        std::atomic<std::uint64_t> hits_{0};
+        std::atomic<std::uint64_t> misses_{0};
+    };
+
+    // Shared cache instance for callers that opt in
+    inline ResolutionCache<> resolutionCache;
+}
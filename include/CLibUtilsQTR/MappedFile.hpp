@@ -0,0 +1,175 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace clib_utilsQTR {
+    /**
+     * @brief Read-only view of a whole file.
+     *
+     * Memory-maps the file where possible and falls back to reading it in one go into an owned buffer
+     * (empty files, mapping failures). Either way view() covers the full contents until Close() or destruction.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        explicit MappedFile(const std::filesystem::path& a_path) { Open(a_path); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& a_other) noexcept { *this = std::move(a_other); }
+
+        MappedFile& operator=(MappedFile&& a_other) noexcept {
+            if (this != &a_other) {
+                Close();
+                data_ = std::exchange(a_other.data_, nullptr);
+                size_ = std::exchange(a_other.size_, 0);
+                mapped_ = std::exchange(a_other.mapped_, false);
+                open_ = std::exchange(a_other.open_, false);
+                buffer_ = std::move(a_other.buffer_);
+                if (!mapped_) data_ = buffer_.data();
+            }
+            return *this;
+        }
+
+        ~MappedFile() { Close(); }
+
+        bool Open(const std::filesystem::path& a_path) {
+            Close();
+            if (Map(a_path)) {
+                mapped_ = true;
+                open_ = true;
+                return true;
+            }
+            return open_ = ReadAll(a_path);
+        }
+
+        void Close() {
+            if (mapped_) Unmap();
+            mapped_ = false;
+            open_ = false;
+            data_ = nullptr;
+            size_ = 0;
+            buffer_.clear();
+        }
+
+        [[nodiscard]] bool is_open() const { return open_; }
+        [[nodiscard]] bool is_mapped() const { return mapped_; }
+        [[nodiscard]] std::size_t size() const { return size_; }
+        [[nodiscard]] std::string_view view() const { return {data_, size_}; }
+
+    private:
+        bool ReadAll(const std::filesystem::path& a_path) {
+            std::ifstream file(a_path, std::ios::binary | std::ios::ate);
+            if (!file.is_open()) return false;
+            const auto size = file.tellg();
+            if (size < 0) return false;
+            buffer_.resize(static_cast<std::size_t>(size));
+            file.seekg(0);
+            if (!file.read(buffer_.data(), size)) {
+                buffer_.clear();
+                return false;
+            }
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+            return true;
+        }
+
+#if defined(_WIN32)
+        bool Map(const std::filesystem::path& a_path) {
+            const HANDLE file = ::CreateFileW(a_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return false;
+
+            LARGE_INTEGER size{};
+            HANDLE mapping = nullptr;
+            if (::GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+                mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            }
+            ::CloseHandle(file);
+            if (!mapping) return false;
+
+            const auto view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            ::CloseHandle(mapping);
+            if (!view) return false;
+
+            data_ = static_cast<const char*>(view);
+            size_ = static_cast<std::size_t>(size.QuadPart);
+            return true;
+        }
+
+        void Unmap() const { ::UnmapViewOfFile(data_); }
+#else
+        bool Map(const std::filesystem::path& a_path) {
+            const int fd = ::open(a_path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+
+            struct stat st{};
+            void* view = MAP_FAILED;
+            if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                view = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd);
+            if (view == MAP_FAILED) return false;
+
+            ::madvise(view, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(view);
+            size_ = static_cast<std::size_t>(st.st_size);
+            return true;
+        }
+
+        void Unmap() const { ::munmap(const_cast<char*>(data_), size_); }
+#endif
+
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+        bool mapped_ = false;
+        bool open_ = false;
+        std::string buffer_;
+    };
+
+    /**
+     * @brief Writes a_chunks back to back into a temporary file next to a_path and renames it over a_path.
+     *
+     * A crash or a failed write never leaves a half-written file behind. Missing parent directories are created.
+     */
+    inline bool WriteFileAtomic(const std::filesystem::path& a_path,
+                                const std::vector<std::span<const std::byte>>& a_chunks) {
+        std::error_code ec;
+        if (a_path.has_parent_path()) std::filesystem::create_directories(a_path.parent_path(), ec);
+        auto temp_path = a_path;
+        temp_path += ".tmp";
+        {
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) return false;
+            for (const auto chunk : a_chunks) {
+                out.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+            }
+            if (!out) return false;
+        }
+        std::filesystem::rename(temp_path, a_path, ec);
+        return !ec;
+    }
+}
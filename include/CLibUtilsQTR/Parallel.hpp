@@ -0,0 +1,95 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace clib_utilsQTR {
+    inline std::size_t DefaultThreadCount() {
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * @brief Runs `a_func(i)` for every i in [0, a_count) on up to `a_threads` threads and waits for all of them.
+     *
+     * Indices are handed out dynamically, so uneven work items balance themselves. The calling thread takes part
+     * in the work. The first exception thrown by a work item is rethrown once every thread has finished.
+     *
+     * @param a_threads Number of threads to use, 0 for DefaultThreadCount().
+     */
+    template <typename Func>
+    void ParallelFor(const std::size_t a_count, Func&& a_func, std::size_t a_threads = 0) {
+        if (a_count == 0) return;
+        if (a_threads == 0) a_threads = DefaultThreadCount();
+        a_threads = std::min(a_threads, a_count);
+
+        if (a_threads == 1) {
+            for (std::size_t i = 0; i < a_count; ++i) a_func(i);
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto work = [&] {
+            for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < a_count;
+                 i = next.fetch_add(1, std::memory_order_relaxed)) {
+                try {
+                    a_func(i);
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(a_threads - 1);
+        for (std::size_t t = 1; t < a_threads; ++t) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        if (error) std::rethrow_exception(error);
+    }
+
+    namespace detail {
+        /**
+         * @brief Bulk-resolve step shared by the staged loaders.
+         *
+         * a_collect is called with a callback taking a std::string_view; every distinct identifier passed to it is
+         * resolved exactly once by `a_resolve(std::string_view, Value&)`, in parallel. The views must outlive the map.
+         */
+        template <typename Value, typename Collect, typename Resolve>
+        std::unordered_map<std::string_view, Value> ResolveDistinct(Collect&& a_collect, Resolve&& a_resolve,
+                                                                    const std::size_t a_threads = 0) {
+            std::unordered_map<std::string_view, Value> resolved;
+            a_collect([&resolved](const std::string_view a_identifier) { resolved.try_emplace(a_identifier); });
+
+            std::vector<std::pair<const std::string_view, Value>*> pending;
+            pending.reserve(resolved.size());
+            for (auto& item : resolved) pending.push_back(&item);
+            ParallelFor(pending.size(), [&](const std::size_t i) {
+                a_resolve(pending[i]->first, pending[i]->second);
+            }, a_threads);
+            return resolved;
+        }
+
+        // Milliseconds since a_start, which is moved to now so consecutive calls time consecutive stages
+        inline double ElapsedMs(std::chrono::steady_clock::time_point& a_start) {
+            const auto now = std::chrono::steady_clock::now();
+            const auto elapsed = std::chrono::duration<double, std::milli>(now - a_start).count();
+            a_start = now;
+            return elapsed;
+        }
+    }
+}
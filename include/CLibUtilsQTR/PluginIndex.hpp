@@ -0,0 +1,164 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CLibUtilsQTR/StringHelpers.hpp"
+
+namespace FormReader {
+    using FormID = RE::FormID;
+
+    struct PluginRecord {
+        std::string_view name;
+        std::uint16_t index = 0;  // compileIndex, or smallFileCompileIndex for light plugins
+        bool light = false;
+    };
+
+    /**
+     * @brief Case-insensitive plugin filename -> compile index table.
+     *
+     * Built once after data load, afterwards LocalID~Plugin resolution is a hash probe plus integer math
+     * instead of TESDataHandler::LookupFormID walking the load order. Flat open addressing keyed by
+     * StringHelpers::fnv1a_ci so compile-time keys can probe it directly.
+     *
+     * Build fills a new table and publishes it with one atomic store, so lookups may run on other threads while
+     * it rebuilds. Lookups return entries by value; the replaced table is only kept until the next rebuild so a
+     * probe that started just before the swap can finish on it.
+     */
+    class PluginIndex {
+    public:
+        struct Entry {
+            std::uint16_t index = 0;
+            bool light = false;
+        };
+
+        void Build(const std::span<const PluginRecord> a_plugins) {
+            auto table = std::make_unique<Table>();
+            table->load_order_hash = StringHelpers::fnv1a("");
+            table->slots.assign(std::bit_ceil(std::max<std::size_t>(a_plugins.size() * 2, 16)), Slot{});
+            table->mask = table->slots.size() - 1;
+
+            for (const auto& [name, index, light] : a_plugins) {
+                if (name.empty()) continue;
+                const auto hash = StringHelpers::fnv1a_ci(name);
+                const std::uint64_t position = index | (light ? 0x10000ull : 0);
+                table->load_order_hash = StringHelpers::fnv1a_ci(name, table->load_order_hash ^ position);
+                auto i = static_cast<std::size_t>(hash) & table->mask;
+                for (; table->slots[i].used; i = (i + 1) & table->mask) {
+                    const auto& other = table->slots[i];
+                    if (other.hash == hash && StringHelpers::iequals(table->NameOf(other), name)) break;
+                }
+                auto& slot = table->slots[i];
+                if (slot.used) continue;  // first occurrence wins, like the load order
+                slot.used = true;
+                slot.hash = hash;
+                slot.name_offset = static_cast<std::uint32_t>(table->names.size());
+                slot.name_length = static_cast<std::uint32_t>(name.size());
+                slot.entry = {index, light};
+                table->names.append(name);
+            }
+
+            std::lock_guard lock(build_mutex_);
+            retired_ = std::move(live_);
+            live_ = std::move(table);
+            table_.store(live_.get(), std::memory_order_release);
+        }
+
+        // Call once on kDataLoaded, the load order does not change afterwards
+        void BuildFromDataHandler() {
+            const auto dataHandler = RE::TESDataHandler::GetSingleton();
+            if (!dataHandler) return;
+
+            const auto& files = dataHandler->compiledFileCollection.files;
+            const auto& smallFiles = dataHandler->compiledFileCollection.smallFiles;
+
+            std::vector<PluginRecord> records;
+            records.reserve(files.size() + smallFiles.size());
+            for (const auto file : files) {
+                if (file) records.push_back({file->GetFilename(), file->compileIndex, false});
+            }
+            for (const auto file : smallFiles) {
+                if (file) records.push_back({file->GetFilename(), file->smallFileCompileIndex, true});
+            }
+            Build(records);
+        }
+
+        [[nodiscard]] bool IsBuilt() const { return table_.load(std::memory_order_acquire) != nullptr; }
+
+        // Changes whenever a plugin is added, removed or moved; used to validate on-disk caches of resolved FormIDs
+        [[nodiscard]] std::uint64_t LoadOrderHash() const {
+            const auto table = table_.load(std::memory_order_acquire);
+            return table ? table->load_order_hash : 0;
+        }
+
+        [[nodiscard]] std::optional<Entry> Find(const std::string_view a_plugin) const {
+            return Find(StringHelpers::fnv1a_ci(a_plugin), a_plugin);
+        }
+
+        // Probe with a precomputed StringHelpers::fnv1a_ci key
+        [[nodiscard]] std::optional<Entry> Find(const std::uint64_t a_hash, const std::string_view a_plugin) const {
+            const auto table = table_.load(std::memory_order_acquire);
+            if (!table) return std::nullopt;
+            const auto& slots = table->slots;
+            for (auto i = static_cast<std::size_t>(a_hash) & table->mask; slots[i].used; i = (i + 1) & table->mask) {
+                if (slots[i].hash == a_hash && StringHelpers::iequals(table->NameOf(slots[i]), a_plugin)) {
+                    return slots[i].entry;
+                }
+            }
+            return std::nullopt;
+        }
+
+        // Same result as TESDataHandler::LookupFormID; 0 if the plugin is not loaded
+        [[nodiscard]] static FormID Compose(const Entry& a_entry, const std::uint32_t a_localId) {
+            if (a_entry.light) {
+                return 0xFE000000 | (static_cast<FormID>(a_entry.index) << 12) | (a_localId & 0xFFF);
+            }
+            return (static_cast<FormID>(a_entry.index) << 24) | (a_localId & 0xFFFFFF);
+        }
+
+        [[nodiscard]] FormID Resolve(const std::uint32_t a_localId, const std::string_view a_plugin) const {
+            if (const auto entry = Find(a_plugin)) return Compose(*entry, a_localId);
+            return 0;
+        }
+
+    private:
+        struct Slot {
+            std::uint64_t hash = 0;
+            std::uint32_t name_offset = 0;
+            std::uint32_t name_length = 0;
+            Entry entry;
+            bool used = false;
+        };
+
+        struct Table {
+            std::vector<Slot> slots;
+            std::string names;
+            std::size_t mask = 0;
+            std::uint64_t load_order_hash = 0;
+
+            [[nodiscard]] std::string_view NameOf(const Slot& a_slot) const {
+                return std::string_view(names).substr(a_slot.name_offset, a_slot.name_length);
+            }
+        };
+
+        std::atomic<const Table*> table_{nullptr};
+        std::unique_ptr<const Table> live_;     // what table_ points to
+        std::unique_ptr<const Table> retired_;  // the previous load order, freed by the next Build
+        std::mutex build_mutex_;
+    };
+
+    inline PluginIndex pluginIndex;
+
+    inline std::uint64_t CurrentLoadOrderHash() {
+        if (pluginIndex.IsBuilt()) return pluginIndex.LoadOrderHash();
+        PluginIndex index;
+        index.BuildFromDataHandler();
+        return index.LoadOrderHash();
+    }
+}
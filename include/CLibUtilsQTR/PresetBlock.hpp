@@ -0,0 +1,122 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace clib_utilsQTR {
+    namespace detail {
+        // Writer lock built on atomic_flag rather than std::mutex, so that holders stay literal types
+        class FlagLock {
+        public:
+            explicit FlagLock(std::atomic_flag& a_flag) : flag_(a_flag) {
+                while (flag_.test_and_set(std::memory_order_acquire)) {
+                    flag_.wait(true, std::memory_order_relaxed);
+                }
+            }
+
+            ~FlagLock() {
+                flag_.clear(std::memory_order_release);
+                flag_.notify_one();
+            }
+
+            FlagLock(const FlagLock&) = delete;
+            FlagLock& operator=(const FlagLock&) = delete;
+
+        private:
+            std::atomic_flag& flag_;
+        };
+    }
+
+    /**
+     * @brief Settings block shared between one or more writer threads (UI, preset switches) and any number of
+     * readers (Tasker workers, hooks) without locking on the read side.
+     *
+     * Two copies of the block are kept. A writer fills the inactive copy and publishes it by bumping a sequence
+     * counter, so readers never block and never see a half-applied preset. The counter is odd while a write is in
+     * progress and advances by two per publish; copy (seq >> 1) & 1 is the last published one. A reader only has to
+     * retry if writers lapped it and started rewriting the copy it was reading, i.e. two publishes during one read.
+     * The type is literal, so a block can be a member of a constexpr object such as PresetPool.
+     *
+     * @code
+     * struct Settings { float range; int max_count; bool enabled; };
+     * clib_utilsQTR::PresetBlock<Settings> settings;
+     *
+     * // UI thread
+     * settings.Update([](Settings& a_settings) { a_settings.range = range_setting; });
+     * // worker thread
+     * const float range = settings.Get(&Settings::range);
+     * @endcode
+     */
+    template <typename Block>
+        requires std::is_trivially_copyable_v<Block>
+    class PresetBlock {
+    public:
+        constexpr PresetBlock() : PresetBlock(Block{}) {}
+
+        constexpr explicit PresetBlock(const Block& a_initial) : blocks_{a_initial, a_initial} {}
+
+        PresetBlock(const PresetBlock&) = delete;
+        PresetBlock& operator=(const PresetBlock&) = delete;
+
+        // Consistent copy of the last published block
+        [[nodiscard]] Block Read() const {
+            Block result;
+            ReadInto([&](const Block& a_block) { Copy(&result, &a_block, sizeof(Block)); });
+            return result;
+        }
+
+        // Single member of the last published block, without copying the rest
+        template <typename Member>
+        [[nodiscard]] Member Get(Member Block::* a_member) const {
+            static_assert(std::is_trivially_copyable_v<Member>);
+            Member result;
+            ReadInto([&](const Block& a_block) { Copy(&result, &(a_block.*a_member), sizeof(Member)); });
+            return result;
+        }
+
+        // a_func: `void(Block&)`, applied to a copy of the current block which is then published as a whole
+        template <typename Func>
+        void Update(Func&& a_func) {
+            detail::FlagLock lock(write_lock_);
+            const auto seq = seq_.load(std::memory_order_relaxed);
+            auto& next = blocks_[((seq >> 1) + 1) & 1];
+
+            seq_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            Copy(&next, &blocks_[(seq >> 1) & 1], sizeof(Block));
+            a_func(next);
+            seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        void Store(const Block& a_block) {
+            Update([&a_block](Block& a_next) { a_next = a_block; });
+        }
+
+        // Number of publishes so far
+        [[nodiscard]] std::uint64_t version() const { return seq_.load(std::memory_order_acquire) >> 1; }
+
+    private:
+        // Byte-wise copy: the source may be rewritten concurrently, which the sequence check detects afterwards
+        static void Copy(void* a_dst, const void* a_src, const std::size_t a_size) {
+            std::memcpy(a_dst, a_src, a_size);
+        }
+
+        template <typename Func>
+        void ReadInto(Func&& a_copy) const {
+            while (true) {
+                const auto s1 = seq_.load(std::memory_order_acquire);
+                a_copy(blocks_[(s1 >> 1) & 1]);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                const auto s2 = seq_.load(std::memory_order_relaxed);
+                // The copy read above is only rewritten once the counter moves past this point
+                if (s2 <= (s1 | 1) + 1) return;
+            }
+        }
+
+        std::atomic<std::uint64_t> seq_ = 0;
+        std::array<Block, 2> blocks_;
+        std::atomic_flag write_lock_;
+    };
+}
@@ -15,6 +15,7 @@ namespace Presets {
         }
 
         bool load(const BlockType& node);
+        const std::string& key() const { return name; }
         T& get() { return value; }
         const T& get() const { return value; }
     };
@@ -0,0 +1,341 @@
+#pragma once
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "CLibUtilsQTR/FormReader.hpp"
+#include "CLibUtilsQTR/FormReaderCache.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FormGroupsSnapshot.hpp"
+
+namespace PresetHelpers {
+    /**
+     * @brief Compiled set expression over form groups, e.g. `WeaponsHeavy - SteelDagger` or `(A + B) & C`.
+     *
+     * `+` is union, `-` difference and `&` intersection; `&` binds tighter than `+`/`-`, which evaluate left to
+     * right, and parentheses group. Operators must have whitespace on both sides so that names like
+     * `Iron-Sword` stay one operand. Operands are group names or single identifiers.
+     * The expression is compiled once into a postfix plan and evaluated with merges of sorted arrays.
+     */
+    class FormExpression {
+    public:
+        enum class Op : std::uint8_t {
+            kOperand,
+            kUnion,
+            kDifference,
+            kIntersection
+        };
+
+        struct Step {
+            Op op;
+            std::uint32_t operand = 0;  // index into operands(), for kOperand
+        };
+
+        // Whether a_text uses operators or parentheses, i.e. is not a plain name or identifier
+        [[nodiscard]] static bool IsExpression(const std::string_view a_text) {
+            const auto text = StringHelpers::trim_view(a_text);
+            if (text.starts_with('(')) return true;
+            for (std::size_t i = 0; i < text.size(); ++i) {
+                if (IsOperatorAt(text, i)) return true;
+            }
+            return false;
+        }
+
+        // nullopt if a_text is malformed, with the reason in a_error
+        [[nodiscard]] static std::optional<FormExpression> Compile(const std::string_view a_text,
+                                                                   std::string* a_error = nullptr) {
+            FormExpression expression;
+            Parser parser{Tokenize(a_text), expression.operands_, expression.steps_};
+            if (parser.tokens.empty()) return Fail(a_error, "empty expression");
+            if (!parser.Expression()) return Fail(a_error, parser.error);
+            if (parser.pos != parser.tokens.size()) return Fail(a_error, "unexpected ')'");
+            return expression;
+        }
+
+        /**
+         * @brief Evaluates the plan.
+         * @param a_lookup Callable `std::span<const FormID>(std::string_view operand)` returning the sorted, unique
+         *                 FormIDs of an operand; the span only has to stay valid until the next call.
+         * @return Sorted, unique FormIDs.
+         */
+        template <typename Lookup>
+        [[nodiscard]] std::vector<FormID> Evaluate(Lookup&& a_lookup) const {
+            std::vector<std::vector<FormID>> stack;
+            std::vector<FormID> merged;
+            for (const auto& [op, operand] : steps_) {
+                if (op == Op::kOperand) {
+                    const std::span<const FormID> ids = a_lookup(std::string_view(operands_[operand]));
+                    stack.emplace_back(ids.begin(), ids.end());
+                    continue;
+                }
+
+                const auto rhs = std::move(stack.back());
+                stack.pop_back();
+                auto& lhs = stack.back();
+                merged.clear();
+                switch (op) {
+                    case Op::kUnion:
+                        std::ranges::set_union(lhs, rhs, std::back_inserter(merged));
+                        break;
+                    case Op::kDifference:
+                        std::ranges::set_difference(lhs, rhs, std::back_inserter(merged));
+                        break;
+                    case Op::kIntersection:
+                        std::ranges::set_intersection(lhs, rhs, std::back_inserter(merged));
+                        break;
+                    default:
+                        break;
+                }
+                lhs.swap(merged);
+            }
+            return stack.empty() ? std::vector<FormID>{} : std::move(stack.back());
+        }
+
+        [[nodiscard]] const std::vector<std::string>& operands() const { return operands_; }
+        [[nodiscard]] const std::vector<Step>& steps() const { return steps_; }
+
+    private:
+        struct Token {
+            enum class Kind : std::uint8_t {
+                kOperand,
+                kOperator,
+                kOpen,
+                kClose
+            };
+
+            Kind kind;
+            std::string_view text;
+        };
+
+        static bool IsSpace(const char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+        static bool IsOperatorAt(const std::string_view a_text, const std::size_t i) {
+            const char c = a_text[i];
+            if (c != '+' && c != '-' && c != '&') return false;
+            const bool space_before = i == 0 || IsSpace(a_text[i - 1]);
+            const bool space_after = i + 1 == a_text.size() || IsSpace(a_text[i + 1]);
+            return space_before && space_after;
+        }
+
+        static std::vector<Token> Tokenize(const std::string_view a_text) {
+            std::vector<Token> tokens;
+            std::size_t i = 0;
+            while (i < a_text.size()) {
+                if (IsSpace(a_text[i])) {
+                    ++i;
+                } else if (a_text[i] == '(') {
+                    tokens.push_back({Token::Kind::kOpen, a_text.substr(i++, 1)});
+                } else if (a_text[i] == ')') {
+                    tokens.push_back({Token::Kind::kClose, a_text.substr(i++, 1)});
+                } else if (IsOperatorAt(a_text, i)) {
+                    tokens.push_back({Token::Kind::kOperator, a_text.substr(i++, 1)});
+                } else {
+                    const auto start = i;
+                    while (i < a_text.size() && a_text[i] != ')' && !IsOperatorAt(a_text, i)) ++i;
+                    tokens.push_back({Token::Kind::kOperand, StringHelpers::trim_view(a_text.substr(start, i - start))});
+                }
+            }
+            return tokens;
+        }
+
+        // Recursive descent: expression = term {('+'|'-') term}, term = factor {'&' factor}
+        struct Parser {
+            std::vector<Token> tokens;
+            std::vector<std::string>& operands;
+            std::vector<Step>& steps;
+            std::size_t pos = 0;
+            std::string error{};
+
+            [[nodiscard]] bool Peek(const Token::Kind a_kind, const char a_op = 0) const {
+                return pos < tokens.size() && tokens[pos].kind == a_kind && (!a_op || tokens[pos].text[0] == a_op);
+            }
+
+            bool Expression() {
+                if (!Term()) return false;
+                while (Peek(Token::Kind::kOperator, '+') || Peek(Token::Kind::kOperator, '-')) {
+                    const auto op = tokens[pos++].text[0] == '+' ? Op::kUnion : Op::kDifference;
+                    if (!Term()) return false;
+                    steps.push_back({op});
+                }
+                return true;
+            }
+
+            bool Term() {
+                if (!Factor()) return false;
+                while (Peek(Token::Kind::kOperator, '&')) {
+                    ++pos;
+                    if (!Factor()) return false;
+                    steps.push_back({Op::kIntersection});
+                }
+                return true;
+            }
+
+            bool Factor() {
+                if (Peek(Token::Kind::kOpen)) {
+                    ++pos;
+                    if (!Expression()) return false;
+                    if (!Peek(Token::Kind::kClose)) {
+                        error = "missing ')'";
+                        return false;
+                    }
+                    ++pos;
+                    return true;
+                }
+                if (!Peek(Token::Kind::kOperand)) {
+                    error = pos < tokens.size() ? "unexpected '" + std::string(tokens[pos].text) + "'"
+                                                : std::string("unexpected end of expression");
+                    return false;
+                }
+                const auto name = tokens[pos++].text;
+                auto it = std::ranges::find(operands, name);
+                if (it == operands.end()) it = operands.insert(operands.end(), std::string(name));
+                steps.push_back({Op::kOperand, static_cast<std::uint32_t>(it - operands.begin())});
+                return true;
+            }
+        };
+
+        static std::optional<FormExpression> Fail(std::string* a_error, const std::string_view a_reason) {
+            if (a_error) *a_error = a_reason;
+            return std::nullopt;
+        }
+
+        std::vector<std::string> operands_;
+        std::vector<Step> steps_;  // postfix
+    };
+
+    /**
+     * @brief Compiled plans plus their last result, keyed by expression text.
+     *
+     * Results are tagged with the FormGroupsVersion() they were computed from and reused until the next publish;
+     * the first evaluation after a publish releases all older results. Holds at most kMaxEntries texts and starts
+     * over when a new one would exceed that.
+     */
+    class FormExpressionCache {
+    public:
+        static constexpr std::size_t kMaxEntries = 1024;
+
+        /**
+         * @brief Appends the result of the expression to a_out.
+         * @return false if a_text is not a valid expression (logged once).
+         */
+        bool Evaluate(const std::string_view a_text, std::vector<FormID>& a_out) {
+            // Version before snapshot: a result may come from a newer snapshot than its tag, never an older one
+            const auto version = FormGroupsVersion();
+            std::shared_ptr<const FormExpression> plan;
+            {
+                std::shared_lock lock(mutex_);
+                if (const auto it = entries_.find(a_text); it != entries_.end()) {
+                    if (!it->second.plan) return false;
+                    if (version != 0 && it->second.version == version) {
+                        a_out.insert(a_out.end(), it->second.result.begin(), it->second.result.end());
+                        return true;
+                    }
+                    plan = it->second.plan;
+                }
+            }
+
+            if (!plan) {
+                std::string error;
+                if (auto compiled = FormExpression::Compile(a_text, &error)) {
+                    plan = std::make_shared<const FormExpression>(std::move(*compiled));
+                } else {
+                    logger::warn("FormGroups: invalid expression '{}': {}", a_text, error);
+                    std::unique_lock lock(mutex_);
+                    Slot(a_text);
+                    return false;
+                }
+            }
+
+            const auto snapshot = AcquireFormGroups();
+            std::vector<FormID> scratch;
+            auto result = plan->Evaluate([&](const std::string_view a_operand) -> std::span<const FormID> {
+                return Operand(snapshot.get(), a_operand, scratch);
+            });
+            a_out.insert(a_out.end(), result.begin(), result.end());
+
+            std::unique_lock lock(mutex_);
+            if (version > results_version_) {
+                for (auto& stale : entries_ | std::views::values) std::vector<FormID>().swap(stale.result);
+                results_version_ = version;
+            }
+            auto& entry = Slot(a_text);
+            entry.plan = std::move(plan);
+            entry.version = version;
+            entry.result = std::move(result);
+            return true;
+        }
+
+        void Clear() {
+            std::unique_lock lock(mutex_);
+            entries_.clear();
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            std::shared_lock lock(mutex_);
+            return entries_.size();
+        }
+
+    private:
+        struct Entry {
+            std::shared_ptr<const FormExpression> plan;  // null if the text failed to compile
+            std::uint64_t version = 0;
+            std::vector<FormID> result;
+        };
+
+        // Entry for a_text, created if missing; caller holds mutex_ exclusively
+        Entry& Slot(const std::string_view a_text) {
+            if (const auto it = entries_.find(a_text); it != entries_.end()) return it->second;
+            if (entries_.size() >= kMaxEntries) entries_.clear();
+            return entries_[std::string(a_text)];
+        }
+
+        static std::span<const FormID> Operand(const FrozenFormGroups* a_snapshot, const std::string_view a_name,
+                                               std::vector<FormID>& a_scratch) {
+            if (a_snapshot) {
+                if (const auto group = a_snapshot->Find(a_name)) return *group;
+            }
+
+            a_scratch.clear();
+            if (const auto formid = FormReader::GetFormEditorIDFromString(a_name); formid > 0) {
+                a_scratch.push_back(formid);
+            }
+            return a_scratch;
+        }
+
+        mutable std::shared_mutex mutex_;
+        std::unordered_map<std::string, Entry, FormReader::StringHash, std::equal_to<>> entries_;
+        std::uint64_t results_version_ = 0;
+    };
+
+    inline FormExpressionCache formExpressionCache;
+
+    // Appends the forms of a group, of a group expression (see FormExpression), or the single form the identifier
+    // resolves to. Safe to call from several threads.
+    inline void AppendFormIDs(const std::string_view input, std::vector<FormID>& out) {
+        if (const auto group = FindFormGroup(input)) {
+            out.insert(out.end(), group->begin(), group->end());
+            return;
+        }
+
+        if (FormExpression::IsExpression(input)) {
+            // Plugin filenames may contain " - ", so a resolvable LocalID~Plugin wins over the expression reading
+            if (input.find('~') != std::string_view::npos) {
+                if (FormID formid = FormReader::GetFormEditorIDFromString(input); formid > 0) {
+                    out.push_back(formid);
+                    return;
+                }
+            }
+            if (formExpressionCache.Evaluate(input, out)) return;
+        }
+
+        if (FormID formid = FormReader::GetFormEditorIDFromString(input); formid > 0) {
+            out.push_back(formid);
+        }
+    }
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "CLibUtilsQTR/FormReaderCache.hpp"
+#include "CLibUtilsQTR/StringHelpers.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FrozenFormGroups.hpp"
+
+namespace PresetHelpers {
+    /**
+     * @brief Form groups that include other groups, with the expanded (transitive) set of each group materialized.
+     *
+     * Groups are edited with Set/Remove and Update() recomputes the closure of only the edited groups and
+     * everything that includes them, dependencies first. Groups that include each other in a cycle all end up
+     * with the union of the cycle; such cycles are reported through Cycles() and logged.
+     * Closures are frozen arrays, so publishing one (FormGroupsEditor::Set) shares it instead of copying.
+     */
+    class FormGroupGraph {
+    public:
+        using FormSet = std::unordered_set<FormID>;
+
+        void Set(const std::string_view a_name, std::vector<FormID> a_forms, std::vector<std::string> a_includes) {
+            auto& node = nodes_[std::string(a_name)];
+            for (const auto& include : node.includes) {
+                if (const auto it = included_by_.find(include); it != included_by_.end()) {
+                    it->second.erase(std::string(a_name));
+                }
+            }
+            node.direct = std::move(a_forms);
+            node.includes = std::move(a_includes);
+            for (const auto& include : node.includes) included_by_[include].insert(std::string(a_name));
+            dirty_.insert(std::string(a_name));
+        }
+
+        void Remove(const std::string_view a_name) {
+            const auto it = nodes_.find(a_name);
+            if (it == nodes_.end()) return;
+            for (const auto& include : it->second.includes) {
+                if (const auto users = included_by_.find(include); users != included_by_.end()) {
+                    users->second.erase(it->first);
+                }
+            }
+            nodes_.erase(it);
+            dirty_.insert(std::string(a_name));
+        }
+
+        [[nodiscard]] bool Contains(const std::string_view a_name) const { return nodes_.contains(a_name); }
+
+        // Expanded, sorted FormIDs of the group as of the last Update(), null if unknown
+        [[nodiscard]] FrozenFormGroups::Ids Closure(const std::string_view a_name) const {
+            if (const auto it = nodes_.find(a_name); it != nodes_.end()) return it->second.closure;
+            return nullptr;
+        }
+
+        // Cycles found by the last Update()
+        [[nodiscard]] const std::vector<std::vector<std::string>>& Cycles() const { return cycles_; }
+
+        /**
+         * @brief Recomputes the closures affected by the Set/Remove calls since the last Update().
+         * @return Names of the existing groups whose closure was recomputed.
+         */
+        std::vector<std::string> Update() {
+            // Everything that (transitively) includes an edited group has to be recomputed too
+            std::unordered_set<std::string, FormReader::StringHash, std::equal_to<>> affected;
+            std::vector<std::string> stack(dirty_.begin(), dirty_.end());
+            dirty_.clear();
+            while (!stack.empty()) {
+                auto name = std::move(stack.back());
+                stack.pop_back();
+                if (!affected.insert(name).second) continue;
+                if (const auto it = included_by_.find(name); it != included_by_.end()) {
+                    stack.insert(stack.end(), it->second.begin(), it->second.end());
+                }
+            }
+
+            std::vector<std::string> changed;
+            for (const auto& name : affected) {
+                if (nodes_.contains(name)) changed.push_back(name);
+            }
+            std::ranges::sort(changed);
+
+            // Tarjan emits strongly connected components dependencies first, so each one can be finished right away
+            cycles_.clear();
+            Tarjan tarjan{*this, affected};
+            for (const auto& name : changed) {
+                if (!tarjan.visited.contains(name)) tarjan.Visit(name);
+            }
+            return changed;
+        }
+
+    private:
+        struct Node {
+            std::vector<FormID> direct;
+            std::vector<std::string> includes;
+            FrozenFormGroups::Ids closure;
+        };
+
+        struct Tarjan {
+            FormGroupGraph& graph;
+            const std::unordered_set<std::string, FormReader::StringHash, std::equal_to<>>& affected;
+            std::unordered_map<std::string_view, std::pair<std::size_t, std::size_t>> visited{};  // index, lowlink
+            std::vector<std::string_view> stack{};
+            std::unordered_set<std::string_view> on_stack{};
+            std::size_t counter = 0;
+
+            void Visit(const std::string_view a_name) {
+                const auto index = counter++;
+                visited[a_name] = {index, index};
+                stack.push_back(a_name);
+                on_stack.insert(a_name);
+
+                const auto& node = graph.nodes_.find(a_name)->second;
+                bool self_loop = false;
+                for (const auto& include : node.includes) {
+                    if (!affected.contains(include) || !graph.nodes_.contains(include)) continue;
+                    if (include == a_name) self_loop = true;
+                    if (!visited.contains(include)) {
+                        Visit(include);
+                        visited[a_name].second = std::min(visited[a_name].second, visited[include].second);
+                    } else if (on_stack.contains(include)) {
+                        visited[a_name].second = std::min(visited[a_name].second, visited[include].first);
+                    }
+                }
+
+                if (visited[a_name].second != index) return;
+
+                std::vector<std::string_view> component;
+                std::string_view member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    on_stack.erase(member);
+                    component.push_back(member);
+                } while (member != a_name);
+
+                Finish(component, self_loop);
+            }
+
+            void Finish(const std::vector<std::string_view>& a_component, const bool a_self_loop) const {
+                const std::unordered_set<std::string_view> members(a_component.begin(), a_component.end());
+                FormSet closure;
+                for (const auto name : a_component) {
+                    const auto& node = graph.nodes_.find(name)->second;
+                    closure.insert(node.direct.begin(), node.direct.end());
+                    for (const auto& include : node.includes) {
+                        if (members.contains(include)) continue;
+                        if (const auto it = graph.nodes_.find(include); it != graph.nodes_.end() && it->second.closure) {
+                            closure.insert(it->second.closure->begin(), it->second.closure->end());
+                        }
+                    }
+                }
+
+                if (a_component.size() > 1 || a_self_loop) {
+                    std::vector<std::string> cycle(a_component.begin(), a_component.end());
+                    std::ranges::sort(cycle);
+                    logger::warn("FormGroups: include cycle between {}", StringHelpers::join(cycle, ", "));
+                    graph.cycles_.push_back(std::move(cycle));
+                }
+
+                const auto frozen = FrozenFormGroups::Freeze(std::vector<FormID>(closure.begin(), closure.end()));
+                for (const auto name : a_component) graph.nodes_.find(name)->second.closure = frozen;
+            }
+        };
+
+        std::unordered_map<std::string, Node, FormReader::StringHash, std::equal_to<>> nodes_;
+        std::unordered_map<std::string, std::unordered_set<std::string>, FormReader::StringHash, std::equal_to<>>
+            included_by_;
+        std::unordered_set<std::string, FormReader::StringHash, std::equal_to<>> dirty_;
+        std::vector<std::vector<std::string>> cycles_;
+    };
+}
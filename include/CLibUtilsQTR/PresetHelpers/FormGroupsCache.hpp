@@ -0,0 +1,206 @@
+#pragma once
+#include <cstring>
+#include <filesystem>
+#include "CLibUtilsQTR/MappedFile.hpp"
+#include "CLibUtilsQTR/PluginIndex.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FormGroupsSnapshot.hpp"
+#include "CLibUtilsQTR/PresetHelpers/PresetHelpersTXT.hpp"
+
+namespace PresetHelpers::TXT_Helpers {
+    /**
+     * Binary snapshot of the resolved groups of one folder:
+     *
+     *   Header | SourceRecord[source_count] | GroupRecord[group_count] | FormID[id_count] | names
+     *
+     * It is only valid for the exact source files (name, size, mtime and content hash) and plugin load order it was
+     * built from. All counts and offsets are checked against the file size before anything is read or allocated.
+     */
+    namespace cache {
+        inline constexpr std::uint32_t kMagic = 0x43474651;  // "QFGC"
+        inline constexpr std::uint32_t kVersion = 2;
+
+        struct Header {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t load_order_hash;
+            std::uint32_t source_count;
+            std::uint32_t group_count;
+            std::uint64_t id_count;
+            std::uint64_t names_size;
+        };
+
+        struct SourceRecord {
+            std::uint64_t content_hash;
+            std::uint64_t size;
+            std::int64_t mtime;  // file_time_type ticks
+            std::uint32_t name_offset;
+            std::uint32_t name_length;
+        };
+
+        struct GroupRecord {
+            std::uint32_t name_offset;
+            std::uint32_t name_length;
+            std::uint32_t id_offset;
+            std::uint32_t id_count;
+        };
+
+        struct Source {
+            std::string name;
+            std::uint64_t content_hash;
+            std::uint64_t size;
+            std::int64_t mtime;
+        };
+
+        // Group files of the folder with their stamp and the hash of their contents, sorted by name
+        inline std::vector<Source> HashSources(const std::string& folder_path) {
+            std::vector<Source> sources;
+            for (const auto& path : detail::ListGroupFiles(folder_path)) {
+                std::error_code time_ec;
+                const auto mtime = std::filesystem::last_write_time(path, time_ec);
+                const clib_utilsQTR::MappedFile file(path);
+                if (time_ec || !file.is_open()) continue;
+                sources.push_back({path.stem().string(), StringHelpers::fnv1a(file.view()), file.view().size(),
+                                   static_cast<std::int64_t>(mtime.time_since_epoch().count())});
+            }
+            return sources;
+        }
+
+        // a_count records at a_offset, advancing a_offset past them; nullptr if they do not fit in a_data
+        template <typename T>
+        const T* Records(const std::string_view a_data, std::size_t& a_offset, const std::uint64_t a_count) {
+            if (a_offset > a_data.size() || a_count > (a_data.size() - a_offset) / sizeof(T)) return nullptr;
+            const auto records = reinterpret_cast<const T*>(a_data.data() + a_offset);
+            a_offset += static_cast<std::size_t>(a_count) * sizeof(T);
+            return records;
+        }
+
+        // Returns false if the snapshot is missing, damaged or stale
+        inline bool Read(const std::filesystem::path& a_path, const std::vector<Source>& a_sources,
+                         const std::uint64_t a_load_order_hash, FrozenFormGroups& a_groups) {
+            const clib_utilsQTR::MappedFile file(a_path);
+            if (!file.is_open()) return false;
+            const auto data = file.view();
+
+            Header header{};
+            if (data.size() < sizeof(Header)) return false;
+            std::memcpy(&header, data.data(), sizeof(Header));
+            if (header.magic != kMagic || header.version != kVersion || header.load_order_hash != a_load_order_hash ||
+                header.source_count != a_sources.size()) {
+                return false;
+            }
+
+            std::size_t offset = sizeof(Header);
+            const auto sources = Records<SourceRecord>(data, offset, header.source_count);
+            if (!sources) return false;
+            const auto groups = Records<GroupRecord>(data, offset, header.group_count);
+            if (!groups) return false;
+            const auto ids = Records<FormID>(data, offset, header.id_count);
+            if (!ids || header.names_size != data.size() - offset) return false;
+            const auto names = data.substr(offset);
+
+            const auto name_of = [&](const std::uint32_t a_offset, const std::uint32_t a_length) {
+                return a_offset + static_cast<std::size_t>(a_length) <= names.size() ? names.substr(a_offset, a_length)
+                                                                                      : std::string_view{};
+            };
+
+            for (std::uint32_t i = 0; i < header.source_count; ++i) {
+                if (sources[i].size != a_sources[i].size || sources[i].mtime != a_sources[i].mtime ||
+                    sources[i].content_hash != a_sources[i].content_hash ||
+                    name_of(sources[i].name_offset, sources[i].name_length) != a_sources[i].name) {
+                    return false;
+                }
+            }
+
+            FrozenFormGroups frozen;
+            for (std::uint32_t i = 0; i < header.group_count; ++i) {
+                const auto& group = groups[i];
+                if (static_cast<std::uint64_t>(group.id_offset) + group.id_count > header.id_count) return false;
+                frozen.Add(name_of(group.name_offset, group.name_length),
+                           std::span<const FormID>(ids + group.id_offset, group.id_count));
+            }
+            a_groups = std::move(frozen);
+            return true;
+        }
+
+        // Replaces the file atomically, see clib_utilsQTR::WriteFileAtomic; group arrays are written in place
+        inline bool Write(const std::filesystem::path& a_path, const std::vector<Source>& a_sources,
+                          const std::uint64_t a_load_order_hash, const FrozenFormGroups& a_groups) {
+            std::string names;
+            std::vector<SourceRecord> sources;
+            std::vector<GroupRecord> groups;
+            std::vector<std::span<const std::byte>> id_chunks;
+            std::uint64_t id_count = 0;
+            for (const auto& [name, content_hash, size, mtime] : a_sources) {
+                sources.push_back({content_hash, size, mtime, static_cast<std::uint32_t>(names.size()),
+                                   static_cast<std::uint32_t>(name.size())});
+                names += name;
+            }
+            a_groups.ForEach([&](const std::string_view a_name, const std::span<const FormID> a_ids) {
+                groups.push_back({static_cast<std::uint32_t>(names.size()), static_cast<std::uint32_t>(a_name.size()),
+                                  static_cast<std::uint32_t>(id_count), static_cast<std::uint32_t>(a_ids.size())});
+                names += a_name;
+                id_chunks.push_back(std::as_bytes(a_ids));
+                id_count += a_ids.size();
+            });
+
+            const Header header{kMagic,
+                                kVersion,
+                                a_load_order_hash,
+                                static_cast<std::uint32_t>(sources.size()),
+                                static_cast<std::uint32_t>(groups.size()),
+                                id_count,
+                                names.size()};
+
+            std::vector<std::span<const std::byte>> chunks{std::as_bytes(std::span(&header, 1)),
+                                                           std::as_bytes(std::span(sources)),
+                                                           std::as_bytes(std::span(groups))};
+            chunks.insert(chunks.end(), id_chunks.begin(), id_chunks.end());
+            chunks.push_back(std::as_bytes(std::span(names)));
+            return clib_utilsQTR::WriteFileAtomic(a_path, chunks);
+        }
+    }
+
+    /**
+     * @brief GatherForms that reuses a binary snapshot of the resolved groups when nothing changed.
+     *
+     * The snapshot is used when every group file has the same size, mtime and content hash as when it was written and
+     * the plugin load order is unchanged; otherwise the folder is parsed with GatherFormsParallel and the snapshot is rewritten.
+     *
+     * @return true if the groups came from the snapshot.
+     */
+    template <typename Resolver = FormReader::GameResolver>
+    bool GatherFormsCached(const std::string& folder_path, const std::filesystem::path& a_cache_path,
+                           GatherTimings* a_timings = nullptr,
+                           const std::uint64_t a_load_order_hash = FormReader::CurrentLoadOrderHash(),
+                           Resolver a_resolver = {}) {
+        auto start = std::chrono::steady_clock::now();
+        const auto sources = cache::HashSources(folder_path);
+
+        if (FrozenFormGroups frozen; cache::Read(a_cache_path, sources, a_load_order_hash, frozen)) {
+            GatherTimings timings;
+            timings.files = sources.size();
+            timings.read_ms = detail::ElapsedMs(start);
+            // The arrays read from the snapshot are published as they are
+            EditFormGroups([&](FormGroupsEditor& a_editor) {
+                for (std::size_t i = 0; i < frozen.size(); ++i) a_editor.Set(frozen.name(i), frozen.Share(i));
+            });
+            timings.merge_ms = detail::ElapsedMs(start);
+            if (a_timings) *a_timings = timings;
+            return true;
+        }
+
+        GatherFormsParallel(folder_path, a_timings, 0, std::move(a_resolver));
+
+        // Sources are sorted by name, so the folder's groups are added in the order Update() would use
+        FrozenFormGroups folder_groups;
+        if (const auto published = AcquireFormGroups()) {
+            for (const auto& source : sources) {
+                if (auto ids = published->Share(source.name)) folder_groups.Add(source.name, std::move(ids));
+            }
+        }
+        if (!cache::Write(a_cache_path, sources, a_load_order_hash, folder_groups)) {
+            logger::warn("FormGroups: could not write snapshot {}", a_cache_path.string());
+        }
+        return false;
+    }
+}
@@ -0,0 +1,188 @@
+#pragma once
+#include <memory>
+#include "CLibUtilsQTR/Ticker.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FormGroupExpressions.hpp"
+#include "CLibUtilsQTR/PresetHelpers/PresetHelpersTXT.hpp"
+
+namespace PresetHelpers::TXT_Helpers {
+    struct ReloadStats {
+        std::size_t added = 0;
+        std::size_t changed = 0;
+        std::size_t removed = 0;
+        std::size_t republished = 0;  // groups whose expanded set was rebuilt, includes dependents
+        double ms = 0.0;
+    };
+
+    /**
+     * @brief Keeps the groups of one folder in sync with the files on disk.
+     *
+     * Each Reload() stats the folder, re-reads only files whose mtime or size changed, and re-parses only those
+     * whose content hash changed. Only the affected groups (and the groups including them) are recomputed, and
+     * the result is published in one EditFormGroups batch; unchanged groups are not copied again.
+     * The first Reload() loads everything.
+     * Either call Reload() on demand or let StartWatching() poll the folder.
+     */
+    template <typename Resolver = FormReader::GameResolver>
+    class FormGroupsReloader {
+    public:
+        explicit FormGroupsReloader(std::string folder_path, Resolver a_resolver = {})
+            : folder_(std::move(folder_path)), resolver_(std::move(a_resolver)) {
+        }
+
+        FormGroupsReloader(const FormGroupsReloader&) = delete;
+        FormGroupsReloader& operator=(const FormGroupsReloader&) = delete;
+
+        ~FormGroupsReloader() { StopWatching(); }
+
+        ReloadStats Reload() {
+            std::lock_guard reload_lock(reload_mutex_);
+            ReloadStats stats;
+            auto start = std::chrono::steady_clock::now();
+
+            // 1) detect added / changed / removed files
+            std::unordered_set<std::string> present;
+            std::vector<std::string> dirty;
+            std::vector<std::string> added;
+            for (const auto& path : detail::ListGroupFiles(folder_)) {
+                auto name = path.stem().string();
+                present.insert(name);
+
+                // A failed stat never counts as unchanged: the content hash decides, and the error values stored
+                // below (min time, size -1) make the next poll look at the file again
+                std::error_code time_ec;
+                std::error_code size_ec;
+                const auto mtime = std::filesystem::last_write_time(path, time_ec);
+                const auto size = std::filesystem::file_size(path, size_ec);
+                const bool stat_failed = time_ec || size_ec;
+
+                const auto it = files_.find(name);
+                if (!stat_failed && it != files_.end() && it->second.mtime == mtime && it->second.size == size) {
+                    continue;
+                }
+
+                const clib_utilsQTR::MappedFile file(path);
+                if (!file.is_open()) continue;
+                const auto hash = StringHelpers::fnv1a(file.view());
+                if (it != files_.end() && it->second.hash == hash) {
+                    it->second.mtime = mtime;
+                    it->second.size = size;
+                    continue;
+                }
+
+                if (it == files_.end()) {
+                    added.push_back(name);
+                } else {
+                    ++stats.changed;
+                }
+                auto& state = files_[name];
+                state.mtime = mtime;
+                state.size = size;
+                state.hash = hash;
+                state.lines.clear();
+                auto text = file.view();
+                std::string_view line;
+                while (StringHelpers::next_line(text, line)) state.lines.emplace_back(line);
+                dirty.push_back(std::move(name));
+            }
+
+            std::vector<std::string> removed;
+            for (const auto& name : files_ | std::views::keys) {
+                if (!present.contains(name)) removed.push_back(name);
+            }
+            stats.added = added.size();
+            stats.removed = removed.size();
+            for (const auto& name : removed) {
+                files_.erase(name);
+                graph_.Remove(name);
+            }
+
+            // A group appearing or disappearing turns matching lines of other files into includes or back
+            if (!added.empty() || !removed.empty()) {
+                std::unordered_set<std::string_view> renamed(removed.begin(), removed.end());
+                renamed.insert(added.begin(), added.end());
+                for (const auto& [name, state] : files_) {
+                    if (std::ranges::find(dirty, name) != dirty.end()) continue;
+                    if (std::ranges::any_of(state.lines, [&](const auto& a_line) { return renamed.contains(a_line); })) {
+                        dirty.push_back(name);
+                    }
+                }
+            }
+
+            // 2) re-parse the dirty files, resolving each distinct identifier once
+            const auto resolved = clib_utilsQTR::detail::ResolveDistinct<FormID>(
+                [&](auto&& a_add) {
+                    for (const auto& name : dirty) {
+                        for (const auto& line : files_.at(name).lines) {
+                            if (!files_.contains(line)) a_add(line);
+                        }
+                    }
+                },
+                [this](const std::string_view a_identifier, FormID& a_formid) { a_formid = resolver_(a_identifier); });
+
+            for (const auto& name : dirty) {
+                std::vector<FormID> forms;
+                std::vector<std::string> includes;
+                for (const auto& line : files_.at(name).lines) {
+                    if (files_.contains(line)) {
+                        includes.push_back(line);
+                    } else if (const auto form = resolved.at(line); form > 0) {
+                        forms.push_back(form);
+                    }
+                }
+                graph_.Set(name, std::move(forms), std::move(includes));
+            }
+
+            // 3) publish the affected groups in one go
+            const auto republish = graph_.Update();
+            stats.republished = republish.size();
+            if (!republish.empty() || !removed.empty()) {
+                EditFormGroups([&](FormGroupsEditor& a_editor) {
+                    for (const auto& name : removed) a_editor.Erase(name);
+                    for (const auto& name : republish) a_editor.Set(name, graph_.Closure(name));
+                });
+                formExpressionCache.Clear();
+            }
+
+            stats.ms = detail::ElapsedMs(start);
+            return stats;
+        }
+
+        // Polls the folder every a_interval on a background thread
+        void StartWatching(const std::chrono::milliseconds a_interval) {
+            StopWatching();
+            ticker_ = std::make_unique<Ticker>([this] {
+                try {
+                    Reload();
+                } catch (const std::exception& e) {
+                    logger::error("FormGroups: reload of {} failed: {}", folder_, e.what());
+                }
+            }, a_interval);
+            ticker_->Start();
+        }
+
+        void StopWatching() {
+            if (ticker_) {
+                ticker_->Stop();
+                ticker_->Join();
+                ticker_.reset();
+            }
+        }
+
+        [[nodiscard]] const std::string& folder() const { return folder_; }
+
+    private:
+        struct FileState {
+            std::filesystem::file_time_type mtime{};
+            std::uintmax_t size = 0;
+            std::uint64_t hash = 0;
+            std::vector<std::string> lines;
+        };
+
+        std::string folder_;
+        Resolver resolver_;
+        std::unordered_map<std::string, FileState, FormReader::StringHash, std::equal_to<>> files_;
+        FormGroupGraph graph_;
+        std::mutex reload_mutex_;
+        std::unique_ptr<Ticker> ticker_;
+    };
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "CLibUtilsQTR/FormReaderCache.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FrozenFormGroups.hpp"
+
+namespace PresetHelpers {
+    // Stable small integer for a group name, valid for the whole session
+    using GroupId = std::uint32_t;
+
+    /**
+     * @brief Append-only group name <-> GroupId table.
+     *
+     * Ids never change or get reused, so callers can look the ids they care about up once at load time and keep
+     * using them across reloads, even if a group disappears and comes back.
+     */
+    class GroupRegistry {
+    public:
+        GroupId Intern(const std::string_view a_name) {
+            {
+                std::shared_lock lock(mutex_);
+                if (const auto it = ids_.find(a_name); it != ids_.end()) return it->second;
+            }
+            std::unique_lock lock(mutex_);
+            if (const auto it = ids_.find(a_name); it != ids_.end()) return it->second;
+            const auto id = static_cast<GroupId>(names_.size());
+            names_.emplace_back(a_name);
+            ids_.emplace(names_.back(), id);
+            return id;
+        }
+
+        [[nodiscard]] std::optional<GroupId> Find(const std::string_view a_name) const {
+            std::shared_lock lock(mutex_);
+            if (const auto it = ids_.find(a_name); it != ids_.end()) return it->second;
+            return std::nullopt;
+        }
+
+        // Empty for unknown ids
+        [[nodiscard]] std::string_view Name(const GroupId a_id) const {
+            std::shared_lock lock(mutex_);
+            return a_id < names_.size() ? std::string_view(names_[a_id]) : std::string_view{};
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            std::shared_lock lock(mutex_);
+            return names_.size();
+        }
+
+    private:
+        mutable std::shared_mutex mutex_;
+        std::deque<std::string> names_;  // deque: Name() views stay valid while interning
+        std::unordered_map<std::string, GroupId, FormReader::StringHash, std::equal_to<>> ids_;
+    };
+
+    inline GroupRegistry groupRegistry;
+
+    /**
+     * @brief FormID -> groups containing it, for one FrozenFormGroups snapshot.
+     *
+     * Open addressing on the FormID; each slot points at a sorted run of GroupIds and also carries a bitmask of
+     * the ids below 64, so membership tests against those are a single probe and a bit test.
+     */
+    class FormGroupsReverseIndex {
+    public:
+        static FormGroupsReverseIndex Build(const FrozenFormGroups& a_groups, GroupRegistry& a_registry) {
+            std::vector<std::pair<FormID, GroupId>> pairs;
+            pairs.reserve(a_groups.id_count());
+            a_groups.ForEach([&](const std::string_view a_name, const std::span<const FormID> a_ids) {
+                const auto id = a_registry.Intern(a_name);
+                for (const auto formid : a_ids) pairs.emplace_back(formid, id);
+            });
+            std::ranges::sort(pairs);
+
+            FormGroupsReverseIndex index;
+            index.groups_.reserve(pairs.size());
+            std::size_t distinct = 0;
+            for (std::size_t i = 0; i < pairs.size(); ++i) {
+                if (i == 0 || pairs[i].first != pairs[i - 1].first) ++distinct;
+            }
+            index.slots_.assign(std::bit_ceil(std::max<std::size_t>(distinct * 2, 16)), Slot{});
+            index.mask_ = index.slots_.size() - 1;
+
+            for (std::size_t i = 0; i < pairs.size();) {
+                const auto formid = pairs[i].first;
+                Slot slot{formid, static_cast<std::uint32_t>(index.groups_.size()), 0, 0, true};
+                for (; i < pairs.size() && pairs[i].first == formid; ++i) {
+                    const auto id = pairs[i].second;
+                    index.groups_.push_back(id);
+                    if (id < 64) slot.low_mask |= 1ull << id;
+                }
+                slot.count = static_cast<std::uint32_t>(index.groups_.size() - slot.offset);
+
+                auto s = Hash(formid) & index.mask_;
+                while (index.slots_[s].used) s = (s + 1) & index.mask_;
+                index.slots_[s] = slot;
+            }
+            return index;
+        }
+
+        // Sorted GroupIds of the groups containing the form, empty if none
+        [[nodiscard]] std::span<const GroupId> GroupsOf(const FormID a_formid) const {
+            if (const auto slot = Find(a_formid)) {
+                return std::span<const GroupId>(groups_).subspan(slot->offset, slot->count);
+            }
+            return {};
+        }
+
+        [[nodiscard]] bool InGroup(const FormID a_formid, const GroupId a_group) const {
+            const auto slot = Find(a_formid);
+            if (!slot) return false;
+            if (a_group < 64) return (slot->low_mask >> a_group) & 1;
+            return std::ranges::binary_search(std::span<const GroupId>(groups_).subspan(slot->offset, slot->count),
+                                              a_group);
+        }
+
+    private:
+        struct Slot {
+            FormID formid = 0;
+            std::uint32_t offset = 0;
+            std::uint32_t count = 0;
+            std::uint64_t low_mask = 0;
+            bool used = false;
+        };
+
+        static std::size_t Hash(const FormID a_formid) {
+            return static_cast<std::size_t>((a_formid * 0x9E3779B97F4A7C15ull) >> 32);
+        }
+
+        [[nodiscard]] const Slot* Find(const FormID a_formid) const {
+            if (slots_.empty()) return nullptr;
+            for (auto s = Hash(a_formid) & mask_; slots_[s].used; s = (s + 1) & mask_) {
+                if (slots_[s].formid == a_formid) return &slots_[s];
+            }
+            return nullptr;
+        }
+
+        std::vector<Slot> slots_;
+        std::vector<GroupId> groups_;
+        std::size_t mask_ = 0;
+    };
+}
@@ -0,0 +1,219 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "CLibUtilsQTR/PresetHelpers/FormGroupsReverseIndex.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FrozenFormGroups.hpp"
+
+namespace PresetHelpers {
+    /**
+     * @brief Read-copy-update storage of the form groups, built for the hot lookup path.
+     *
+     * The published FrozenFormGroups snapshot is the only copy of the groups. Writers change them through
+     * EditFormGroups() (or SetFormGroup / EraseFormGroup), which publishes the batch before it returns: the new
+     * snapshot holds new arrays only for the touched groups and shares every other group's array with the previous
+     * one. The hash sets a writer may edit in place only live inside its batch.
+     *
+     * Readers never take a lock and never publish: each thread keeps the snapshot it last saw and only re-acquires
+     * it when the published version changed, so a lookup is one atomic load plus one hash probe. A thread holds on to
+     * its old snapshot until its next lookup, which is what keeps returned spans alive while a reload publishes
+     * underneath it.
+     */
+    using FormGroupsSnapshot = std::shared_ptr<const FrozenFormGroups>;
+
+    namespace detail {
+        inline std::atomic<FormGroupsSnapshot> formGroupsSnapshot_;
+        inline std::atomic<std::shared_ptr<const FormGroupsReverseIndex>> formGroupsReverse_;
+        inline std::atomic<std::uint64_t> formGroupsVersion_{0};
+        inline std::atomic<bool> formGroupsReverseEnabled_{false};
+        inline std::mutex formGroupsWrite_mutex_;  // serializes writers, readers never take it
+
+        // Caller holds formGroupsWrite_mutex_
+        inline void Publish(std::shared_ptr<const FrozenFormGroups> a_snapshot) {
+            std::shared_ptr<const FormGroupsReverseIndex> reverse;
+            if (formGroupsReverseEnabled_.load(std::memory_order_relaxed)) {
+                reverse = std::make_shared<const FormGroupsReverseIndex>(
+                    FormGroupsReverseIndex::Build(*a_snapshot, groupRegistry));
+            }
+            formGroupsReverse_.store(std::move(reverse), std::memory_order_release);
+            formGroupsSnapshot_.store(std::move(a_snapshot), std::memory_order_release);
+            formGroupsVersion_.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        struct ThreadSnapshot {
+            std::uint64_t version = 0;
+            FormGroupsSnapshot snapshot;
+            std::shared_ptr<const FormGroupsReverseIndex> reverse;
+        };
+
+        inline const ThreadSnapshot& CurrentThreadSnapshot() {
+            thread_local ThreadSnapshot local;
+            if (const auto version = formGroupsVersion_.load(std::memory_order_acquire); version != local.version) {
+                local.snapshot = formGroupsSnapshot_.load(std::memory_order_acquire);
+                local.reverse = formGroupsReverse_.load(std::memory_order_acquire);
+                local.version = version;
+            }
+            return local;
+        }
+
+        inline const FrozenFormGroups* CurrentSnapshot() { return CurrentThreadSnapshot().snapshot.get(); }
+    }
+
+    // Staged changes of one EditFormGroups batch, applied to the published snapshot when the batch ends
+    class FormGroupsEditor {
+    public:
+        // Replaces the group; a_ids does not need to be sorted or unique
+        void Set(const std::string_view a_group, std::vector<FormID> a_ids) {
+            Set(a_group, FrozenFormGroups::Freeze(std::move(a_ids)));
+        }
+
+        // Replaces the group with a shared array, which must be sorted and unique (see FrozenFormGroups::Freeze)
+        void Set(const std::string_view a_group, FrozenFormGroups::Ids a_ids) {
+            edits_.erase(std::string(a_group));
+            changes_.insert_or_assign(std::string(a_group), std::move(a_ids));
+        }
+
+        bool Erase(const std::string_view a_group) {
+            if (!Contains(a_group)) return false;
+            edits_.erase(std::string(a_group));
+            changes_.insert_or_assign(std::string(a_group), nullptr);
+            return true;
+        }
+
+        /**
+         * @brief Hash set of the group for in-place edits, created if missing; counts as changed.
+         *
+         * Starts out with the group's current FormIDs and is frozen into a sorted array when the batch ends.
+         */
+        std::unordered_set<FormID>& operator[](const std::string_view a_group) {
+            if (const auto it = edits_.find(a_group); it != edits_.end()) return it->second;
+            const auto current = Get(a_group);
+            auto& edit = edits_[std::string(a_group)];
+            edit.insert(current.begin(), current.end());
+            return edit;
+        }
+
+        [[nodiscard]] bool Contains(const std::string_view a_group) const {
+            if (edits_.contains(a_group)) return true;
+            if (const auto it = changes_.find(a_group); it != changes_.end()) return it->second != nullptr;
+            return base_ && base_->HasGroup(a_group);
+        }
+
+        // FormIDs of the group including the staged Set/Erase calls; a group opened with operator[] reads as it was then
+        [[nodiscard]] std::span<const FormID> Get(const std::string_view a_group) const {
+            if (const auto it = changes_.find(a_group); it != changes_.end()) {
+                return it->second ? std::span<const FormID>(*it->second) : std::span<const FormID>{};
+            }
+            return base_ ? base_->Get(a_group) : std::span<const FormID>{};
+        }
+
+    private:
+        template <typename Func>
+        friend void EditFormGroups(Func&& a_func);
+
+        explicit FormGroupsEditor(FormGroupsSnapshot a_base) : base_(std::move(a_base)) {}
+
+        FrozenFormGroups::Changes Finish() {
+            for (auto& [name, edit] : edits_) {
+                changes_[name] = FrozenFormGroups::Freeze(std::vector<FormID>(edit.begin(), edit.end()));
+            }
+            edits_.clear();
+            return std::move(changes_);
+        }
+
+        FormGroupsSnapshot base_;
+        FrozenFormGroups::Changes changes_;
+        std::unordered_map<std::string, std::unordered_set<FormID>, FormReader::StringHash, std::equal_to<>> edits_;
+    };
+
+    /**
+     * @brief Applies a batch of group edits and publishes them before returning.
+     *
+     * a_func is called as `void(FormGroupsEditor&)` while the writer lock is held, so it must not call EditFormGroups
+     * itself; lookups keep working meanwhile and see either none or all of the batch. A batch without edits does not
+     * publish.
+     */
+    template <typename Func>
+    void EditFormGroups(Func&& a_func) {
+        std::lock_guard lock(detail::formGroupsWrite_mutex_);
+        const auto base = detail::formGroupsSnapshot_.load(std::memory_order_acquire);
+        FormGroupsEditor editor(base);
+        a_func(editor);
+        const auto changes = editor.Finish();
+        if (changes.empty()) return;
+        detail::Publish(std::make_shared<const FrozenFormGroups>(
+            FrozenFormGroups::Update(base ? *base : FrozenFormGroups{}, changes)));
+    }
+
+    inline void SetFormGroup(const std::string_view a_group, std::vector<FormID> a_ids) {
+        EditFormGroups([&](FormGroupsEditor& a_editor) { a_editor.Set(a_group, std::move(a_ids)); });
+    }
+
+    inline bool EraseFormGroup(const std::string_view a_group) {
+        bool erased = false;
+        EditFormGroups([&](FormGroupsEditor& a_editor) { erased = a_editor.Erase(a_group); });
+        return erased;
+    }
+
+    /**
+     * @brief Turns the FormID -> groups index (GroupsOf / InGroup) on or off.
+     *
+     * Off by default since it costs a second copy of every membership. When turned on after groups were already
+     * published, they are republished right away with the index.
+     */
+    inline void EnableGroupsOfIndex(const bool a_enable) {
+        if (detail::formGroupsReverseEnabled_.exchange(a_enable) == a_enable) return;
+        if (!a_enable) return;
+        std::lock_guard lock(detail::formGroupsWrite_mutex_);
+        if (auto snapshot = detail::formGroupsSnapshot_.load(std::memory_order_acquire)) {
+            detail::Publish(std::move(snapshot));
+        }
+    }
+
+    // Increases with every publish; 0 means nothing was published yet
+    inline std::uint64_t FormGroupsVersion() {
+        return detail::formGroupsVersion_.load(std::memory_order_acquire);
+    }
+
+    // Shared ownership of the published snapshot, for callers that keep spans across lookups. May be null.
+    inline FormGroupsSnapshot AcquireFormGroups() {
+        return detail::formGroupsSnapshot_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Sorted FormIDs of a published group, without copying or locking.
+     *
+     * The span stays valid until the calling thread does its next lookup after a newer publish; use
+     * AcquireFormGroups() to keep it longer. Returns nullopt if the group is unknown or nothing was published.
+     */
+    inline std::optional<std::span<const FormID>> FindFormGroup(const std::string_view a_group) {
+        const auto snapshot = detail::CurrentSnapshot();
+        if (!snapshot) return std::nullopt;
+        return snapshot->Find(a_group);
+    }
+
+    // Interns the group name; do this at load time and keep the id for GroupsOf / InGroup
+    inline GroupId GetGroupId(const std::string_view a_group) { return groupRegistry.Intern(a_group); }
+
+    /**
+     * @brief GroupIds of the published groups containing the form, sorted; see groupRegistry.Name().
+     *
+     * Empty unless EnableGroupsOfIndex(true) was called. Same lifetime rules as FindFormGroup.
+     */
+    inline std::span<const GroupId> GroupsOf(const FormID a_formid) {
+        const auto& reverse = detail::CurrentThreadSnapshot().reverse;
+        return reverse ? reverse->GroupsOf(a_formid) : std::span<const GroupId>{};
+    }
+
+    // Whether the form is in the published group; always false unless EnableGroupsOfIndex(true) was called
+    inline bool InGroup(const FormID a_formid, const GroupId a_group) {
+        const auto& reverse = detail::CurrentThreadSnapshot().reverse;
+        return reverse && reverse->InGroup(a_formid, a_group);
+    }
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "CLibUtilsQTR/FormReaderCache.hpp"
+#include "CLibUtilsQTR/PresetHelpers/PresetHelpers.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CLIBUTILSQTR_SSE2 1
+#endif
+
+namespace PresetHelpers {
+    /**
+     * @brief Immutable form groups: every group is a sorted array of FormIDs.
+     *
+     * This is the only stored form of the published groups (see FormGroupsSnapshot.hpp): 4 bytes per entry instead
+     * of a hash node, iteration is a plain span and membership is a branchless search that finishes with a SIMD scan.
+     * Arrays are reference counted, so Update() can derive the next snapshot from the previous one and only the
+     * groups that changed are new, and FormGroupGraph closures are the very arrays that get published.
+     */
+    class FrozenFormGroups {
+    public:
+        using Ids = std::shared_ptr<const std::vector<FormID>>;
+        // Replacement arrays by group name; a null array drops the group
+        using Changes = std::unordered_map<std::string, Ids, FormReader::StringHash, std::equal_to<>>;
+
+        // Sorted, unique array for a_ids, in the shape Add and Update share
+        static Ids Freeze(std::vector<FormID> a_ids) {
+            if (!std::ranges::is_sorted(a_ids)) std::ranges::sort(a_ids);
+            a_ids.erase(std::unique(a_ids.begin(), a_ids.end()), a_ids.end());
+            return std::make_shared<const std::vector<FormID>>(std::move(a_ids));
+        }
+
+        /**
+         * @brief a_previous with a_changes applied.
+         *
+         * Groups named in a_changes take the new array or are dropped; all other groups share their array with
+         * a_previous.
+         */
+        static FrozenFormGroups Update(const FrozenFormGroups& a_previous, const Changes& a_changes) {
+            std::vector<Group> groups;
+            groups.reserve(a_previous.size() + a_changes.size());
+            for (const auto& group : a_previous.groups_) {
+                if (!a_changes.contains(group.name)) groups.push_back(group);
+            }
+            for (const auto& [name, ids] : a_changes) {
+                if (ids) groups.push_back({name, ids});
+            }
+            std::ranges::sort(groups, {}, &Group::name);
+
+            FrozenFormGroups frozen;
+            frozen.groups_.reserve(groups.size());
+            for (auto& group : groups) frozen.Add(group.name, std::move(group.ids));
+            return frozen;
+        }
+
+        // Appends a group; a_ids does not need to be sorted or unique. Returns false if the name is taken.
+        bool Add(const std::string_view a_name, const std::span<const FormID> a_ids) {
+            if (index_.contains(a_name)) return false;
+            return Add(a_name, Freeze(std::vector<FormID>(a_ids.begin(), a_ids.end())));
+        }
+
+        // Appends a group sharing a_ids, which must already be sorted and unique (see Freeze)
+        bool Add(const std::string_view a_name, Ids a_ids) {
+            if (index_.contains(a_name)) return false;
+            index_.emplace(std::string(a_name), static_cast<std::uint32_t>(groups_.size()));
+            id_count_ += a_ids->size();
+            groups_.push_back({std::string(a_name), std::move(a_ids)});
+            return true;
+        }
+
+        [[nodiscard]] bool HasGroup(const std::string_view a_group) const { return index_.contains(a_group); }
+
+        // Sorted FormIDs of the group, empty if unknown. Valid as long as this object lives.
+        [[nodiscard]] std::span<const FormID> Get(const std::string_view a_group) const {
+            if (const auto it = index_.find(a_group); it != index_.end()) return Get(it->second);
+            return {};
+        }
+
+        // Like Get, but tells an empty group apart from an unknown one
+        [[nodiscard]] std::optional<std::span<const FormID>> Find(const std::string_view a_group) const {
+            if (const auto it = index_.find(a_group); it != index_.end()) return Get(it->second);
+            return std::nullopt;
+        }
+
+        [[nodiscard]] std::span<const FormID> Get(const std::size_t a_index) const { return *groups_[a_index].ids; }
+
+        // The array behind Get(a_index), for snapshots that want to share it
+        [[nodiscard]] const Ids& Share(const std::size_t a_index) const { return groups_[a_index].ids; }
+
+        // The array behind Get(a_group), null if unknown
+        [[nodiscard]] Ids Share(const std::string_view a_group) const {
+            if (const auto it = index_.find(a_group); it != index_.end()) return Share(it->second);
+            return nullptr;
+        }
+
+        [[nodiscard]] bool Contains(const std::string_view a_group, const FormID a_formid) const {
+            return Contains(Get(a_group), a_formid);
+        }
+
+        static bool Contains(const std::span<const FormID> a_sorted, const FormID a_formid) {
+            const FormID* base = a_sorted.data();
+            std::size_t n = a_sorted.size();
+            if (n == 0) return false;
+
+            // Narrow down to a small window that must hold a_formid if it is present, without branching on data
+            while (n > 16) {
+                const auto half = n / 2;
+                base = base[half] <= a_formid ? base + half : base;
+                n -= half;
+            }
+
+            std::size_t i = 0;
+#ifdef CLIBUTILSQTR_SSE2
+            const __m128i needle = _mm_set1_epi32(static_cast<int>(a_formid));
+            for (; i + 4 <= n; i += 4) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + i));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(block, needle))) return true;
+            }
+#endif
+            for (; i < n; ++i) {
+                if (base[i] == a_formid) return true;
+            }
+            return false;
+        }
+
+        // Visits (name, sorted FormIDs) in insertion order; Update inserts by name
+        template <typename Func>
+        void ForEach(Func&& a_func) const {
+            for (std::size_t i = 0; i < groups_.size(); ++i) a_func(std::string_view(groups_[i].name), Get(i));
+        }
+
+        [[nodiscard]] std::size_t size() const { return groups_.size(); }
+        [[nodiscard]] bool empty() const { return groups_.empty(); }
+        // Total FormIDs over all groups
+        [[nodiscard]] std::size_t id_count() const { return id_count_; }
+        [[nodiscard]] std::string_view name(const std::size_t a_index) const { return groups_[a_index].name; }
+
+    private:
+        struct Group {
+            std::string name;
+            Ids ids;
+        };
+
+        std::vector<Group> groups_;
+        std::size_t id_count_ = 0;
+        std::unordered_map<std::string, std::uint32_t, FormReader::StringHash, std::equal_to<>> index_;
+    };
+}
@@ -2,6 +2,7 @@
 #include <type_traits>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <rapidjson/document.h>
 
 namespace Presets {
@@ -27,7 +28,13 @@ namespace Presets {
             bool GetScalar(const rapidjson::Value& val, T& out) {
                 if constexpr (std::is_same_v<T, std::string>) {
                     if (val.IsString()) {
-                        out = val.GetString();
+                        out.assign(val.GetString(), val.GetStringLength());
+                        return true;
+                    }
+                } else if constexpr (std::is_same_v<T, std::string_view>) {
+                    // Points into the document (or the in-situ buffer), see JSONLoadContext
+                    if (val.IsString()) {
+                        out = std::string_view(val.GetString(), val.GetStringLength());
                         return true;
                     }
                 } else if constexpr (std::is_same_v<T, float>) {
@@ -79,14 +86,16 @@ namespace Presets {
 
                     if (!val.IsArray()) return false;
                     const auto& arr = val.GetArray();
-                    a_to_set.reserve(arr.Size());
+                    T result;
+                    result.reserve(arr.Size());
 
                     for (const auto& item : arr) {
                         ElemType temp;
                         if (!GetScalar(item, temp)) return false;
-                        a_to_set.push_back(std::move(temp));
+                        result.push_back(std::move(temp));
                     }
 
+                    a_to_set = std::move(result);
                     return true;
                 } else {
                     return GetScalar(val, a_to_set);
@@ -96,24 +105,35 @@ namespace Presets {
 
             template <typename T>
             bool Get(const rapidjson::Value& obj, const std::string& key, T& out) {
-                if (!obj.IsObject() || !obj.HasMember(key.c_str())) return false;
-                const auto& val = obj[key.c_str()];
-                return Get(val, out);
+                if (!obj.IsObject()) return false;
+                const auto it = obj.FindMember(key.c_str());
+                if (it == obj.MemberEnd()) return false;
+                return Get(it->value, out);
             }
         }
 
+        /**
+         * Other block types plug in by specializing this with
+         * `template <typename T> static bool Get(const BlockType&, const std::string&, T&)`,
+         * see GettersYAML.hpp.
+         */
+        template <typename BlockType>
+        struct BlockGetter {
+            template <typename T>
+            static bool Get(const BlockType&, const std::string&, T&) {
+                static_assert(always_false_v<BlockType>, "Unsupported block type");
+                return false;
+            }
+        };
+
+        // Writes a_val only on success; scalars are written in place, vectors are moved in once complete
         template <typename T, typename BlockType>
-        bool GetValue(const BlockType& a_block, std::string& a_name, T& a_val) {
-            T result;
+        bool GetValue(const BlockType& a_block, const std::string& a_name, T& a_val) {
             if constexpr (std::is_same_v<BlockType, rapidjson::Value>) {
-                if (JSON::Get<T>(a_block, a_name, result)) {
-                    a_val = result;
-                    return true;
-                }
+                return JSON::Get<T>(a_block, a_name, a_val);
             } else {
-                // Add other types as needed
+                return BlockGetter<BlockType>::template Get<T>(a_block, a_name, a_val);
             }
-            return false;
         }
     }
 }
\ No newline at end of file
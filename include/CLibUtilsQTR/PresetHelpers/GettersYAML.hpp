@@ -0,0 +1,206 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "yaml-cpp/yaml.h"
+#include "CLibUtilsQTR/PresetHelpers/Getters.hpp"
+#include "CLibUtilsQTR/PresetHelpers/Schema.hpp"
+
+namespace Presets {
+    namespace Getters {
+        /**
+         * Typed getters for yaml-cpp nodes, mirroring Getters::JSON.
+         *
+         * Scalars are converted straight from the node's source text with std::from_chars instead of
+         * YAML::Node::as<T>(), which goes through a std::stringstream per value. The accepted spellings follow
+         * yaml-cpp's own conversions (0x hex and leading-0 octal integers, .inf / .nan, yes / on / true ...).
+         */
+        namespace YAML {
+            template <typename T>
+            inline constexpr bool is_scalar_v =
+                std::is_same_v<T, std::string> || std::is_same_v<T, bool> || std::is_arithmetic_v<T>;
+
+            namespace detail {
+                // yaml-cpp accepts the all-lower, Capitalized and ALL-UPPER spellings only
+                inline bool MatchesWord(const std::string_view a_text, const std::string_view a_lower) {
+                    if (a_text.size() != a_lower.size()) return false;
+                    if (a_text == a_lower) return true;
+                    const auto upper = [](const char c) { return static_cast<char>(c - 'a' + 'A'); };
+                    if (a_text[0] != upper(a_lower[0])) return false;
+                    if (a_text.substr(1) == a_lower.substr(1)) return true;
+                    for (std::size_t i = 1; i < a_text.size(); ++i) {
+                        if (a_text[i] != upper(a_lower[i])) return false;
+                    }
+                    return true;
+                }
+
+                inline bool ParseBool(const std::string_view a_text, bool& a_out) {
+                    for (const auto word : {"y", "yes", "true", "on"}) {
+                        if (MatchesWord(a_text, word)) {
+                            a_out = true;
+                            return true;
+                        }
+                    }
+                    for (const auto word : {"n", "no", "false", "off"}) {
+                        if (MatchesWord(a_text, word)) {
+                            a_out = false;
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                inline bool IsDigitIn(const char c, const int a_base) {
+                    if (a_base == 16) return std::isxdigit(static_cast<unsigned char>(c)) != 0;
+                    return c >= '0' && c < static_cast<char>('0' + a_base);
+                }
+
+                /**
+                 * yaml-cpp reads integers through a stream with automatic base: 0x / 0X is hex, any other leading 0
+                 * octal (so "010" is 8 and "0o17" is rejected), the rest decimal. Those plain spellings are parsed
+                 * here; anything else (a sign before a prefix, trailing blanks, ...) goes through YAML::convert, so
+                 * the result always matches as<T>().
+                 */
+                template <typename T>
+                bool ParseInteger(const ::YAML::Node& a_node, std::string_view a_text, T& a_out) {
+                    const bool plus = a_text.starts_with('+');
+                    if (plus) a_text.remove_prefix(1);
+                    const bool negative = !plus && a_text.starts_with('-');
+                    auto digits = a_text.substr(negative ? 1 : 0);
+
+                    int base = 10;
+                    if (digits.size() > 1 && digits[0] == '0') {
+                        base = digits[1] == 'x' || digits[1] == 'X' ? 16 : 8;
+                        digits.remove_prefix(base == 16 ? 2 : 1);
+                    }
+                    if (digits.empty() || (negative && base != 10) ||
+                        !std::ranges::all_of(digits, [base](const char c) { return IsDigitIn(c, base); })) {
+                        return ::YAML::convert<T>::decode(a_node, a_out);
+                    }
+
+                    const auto text = base == 10 ? a_text : digits;
+                    const auto end = text.data() + text.size();
+                    const auto [ptr, ec] = std::from_chars(text.data(), end, a_out, base);
+                    return ec == std::errc() && ptr == end;
+                }
+
+                template <typename T>
+                bool ParseFloat(std::string_view a_text, T& a_out) {
+                    if (a_text == ".inf" || a_text == ".Inf" || a_text == ".INF" || a_text == "+.inf" ||
+                        a_text == "+.Inf" || a_text == "+.INF") {
+                        a_out = std::numeric_limits<T>::infinity();
+                        return true;
+                    }
+                    if (a_text == "-.inf" || a_text == "-.Inf" || a_text == "-.INF") {
+                        a_out = -std::numeric_limits<T>::infinity();
+                        return true;
+                    }
+                    if (a_text == ".nan" || a_text == ".NaN" || a_text == ".NAN") {
+                        a_out = std::numeric_limits<T>::quiet_NaN();
+                        return true;
+                    }
+                    // from_chars also takes inf / nan / infinity in any case, and a '-' left after a '+' ("+-1"),
+                    // none of which the stream behind as<T>() accepts; a number starts with a digit or '.'
+                    const bool plus = a_text.starts_with('+');
+                    if (plus) a_text.remove_prefix(1);
+                    const auto digits = a_text.substr(!plus && a_text.starts_with('-') ? 1 : 0);
+                    if (digits.empty() || !(std::isdigit(static_cast<unsigned char>(digits[0])) || digits[0] == '.')) {
+                        return false;
+                    }
+                    const auto end = a_text.data() + a_text.size();
+                    const auto [ptr, ec] = std::from_chars(a_text.data(), end, a_out);
+                    return ec == std::errc() && ptr == end;
+                }
+            }
+
+            template <typename T>
+            bool GetScalar(const ::YAML::Node& node, T& out) {
+                if (!node.IsScalar()) return false;
+                const std::string& text = node.Scalar();  // reference into the node, no copy
+
+                if constexpr (std::is_same_v<T, std::string>) {
+                    out = text;
+                    return true;
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    return detail::ParseBool(text, out);
+                } else if constexpr (std::is_floating_point_v<T>) {
+                    return detail::ParseFloat(text, out);
+                } else if constexpr (std::is_integral_v<T>) {
+                    return detail::ParseInteger(node, text, out);
+                } else {
+                    static_assert(always_false_v<T>, "Unsupported scalar type");
+                }
+                return false;
+            }
+
+            template <HasSchema T>
+            bool GetStruct(const ::YAML::Node& a_map, T& a_out);
+
+            // Same shapes as JSON::GetMember: nested schema structs, Fields, vectors (sequences) and scalars
+            template <typename T>
+            bool Get(const ::YAML::Node& node, T& a_to_set) {
+                if constexpr (HasSchema<T>) {
+                    return GetStruct(node, a_to_set);
+                } else if constexpr (Presets::detail::is_field_v<T>) {
+                    return Get(node, a_to_set.get());
+                } else if constexpr (Presets::detail::is_std_vector_v<T>) {
+                    if (!node.IsSequence()) return false;
+                    T result;
+                    result.reserve(node.size());
+                    for (const auto& item : node) {
+                        typename T::value_type temp{};
+                        if (!Get(item, temp)) return false;
+                        result.push_back(std::move(temp));
+                    }
+                    a_to_set = std::move(result);
+                    return true;
+                } else {
+                    return GetScalar(node, a_to_set);
+                }
+            }
+
+            template <typename T>
+            bool Get(const ::YAML::Node& map, const std::string& key, T& out) {
+                if (!map.IsMap()) return false;
+                const auto node = map[key];  // const lookup, does not insert
+                if (!node.IsDefined()) return false;
+                return Get(node, out);
+            }
+
+            // Single walk over the map, see JSON::GetStruct
+            template <HasSchema T>
+            bool GetStruct(const ::YAML::Node& a_map, T& a_out) {
+                if (!a_map.IsMap()) return false;
+                constexpr const auto& schema = SchemaOf<T>::value;
+                for (const auto& pair : a_map) {
+                    if (!pair.first.IsScalar()) continue;
+                    const std::string_view name = pair.first.Scalar();
+                    const auto hash = StringHelpers::fnv1a(name);
+                    std::apply(
+                        [&](const auto&... a_field) {
+                            (void)((a_field.hash == hash && a_field.key == name &&
+                                    (Get(pair.second, a_out.*a_field.member), true)) ||
+                                   ...);
+                        },
+                        schema.fields);
+                }
+                return true;
+            }
+        }
+
+        // Lets Field<T, YAML::Node> load through Getters::GetValue
+        template <>
+        struct BlockGetter<::YAML::Node> {
+            template <typename T>
+            static bool Get(const ::YAML::Node& a_block, const std::string& a_name, T& a_val) {
+                return YAML::Get<T>(a_block, a_name, a_val);
+            }
+        };
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include "CLibUtilsQTR/MappedFile.hpp"
+
+namespace Presets {
+    /**
+     * @brief Reusable state for loading many JSON presets one after another.
+     *
+     * Holds the text buffer the documents are parsed in situ into, a MemoryPoolAllocator for the values and one for
+     * rapidjson's parse stack, all backed by buffers owned by the context. Each load clears them instead of freeing
+     * them; when a document needed more than the buffers hold, they are regrown to that peak for the next load. Once
+     * the largest file has been seen, loads do not touch the heap.
+     *
+     * The document returned by Load/Parse, and every string read from it (use std::string_view fields to avoid
+     * copies), point into the context and stay valid until the next Load/Parse.
+     */
+    template <unsigned ParseFlags = rapidjson::kParseDefaultFlags>
+    class JSONLoadContext {
+    public:
+        using Allocator = rapidjson::MemoryPoolAllocator<>;
+        using Document = rapidjson::GenericDocument<rapidjson::UTF8<>, Allocator, Allocator>;
+
+        explicit JSONLoadContext(const std::size_t a_value_bytes = 64 * 1024, const std::size_t a_stack_bytes = 16 * 1024)
+            : value_capacity_(a_value_bytes), stack_capacity_(a_stack_bytes) {
+        }
+
+        JSONLoadContext(const JSONLoadContext&) = delete;
+        JSONLoadContext& operator=(const JSONLoadContext&) = delete;
+
+        // nullptr if the file could not be read or parsed (logged)
+        const Document* Load(const std::filesystem::path& a_path) {
+            const clib_utilsQTR::MappedFile file(a_path);
+            if (!file.is_open()) {
+                logger::error("Failed to open {}", a_path.string());
+                return nullptr;
+            }
+            return ParseCopy(file.view(), a_path);
+        }
+
+        // Parses a copy of a_json; a_json itself does not have to outlive the document
+        const Document* Parse(const std::string_view a_json, const std::string_view a_source = "<string>") {
+            return ParseCopy(a_json, a_source);
+        }
+
+        // The document of the last successful load, nullptr otherwise
+        [[nodiscard]] const Document* document() const {
+            return document_ && !document_->HasParseError() ? &*document_ : nullptr;
+        }
+
+        [[nodiscard]] std::size_t value_capacity() const { return value_capacity_; }
+        [[nodiscard]] std::size_t stack_capacity() const { return stack_capacity_; }
+
+    private:
+        static constexpr std::size_t kInitialStack = 1024;
+
+        // a_source is a path or a name; a path is only turned into a string for the error message
+        template <typename Source>
+        const Document* ParseCopy(const std::string_view a_json, const Source& a_source) {
+            Reset();
+
+            text_.resize(a_json.size() + 1);  // keeps its capacity across loads
+            std::memcpy(text_.data(), a_json.data(), a_json.size());
+            text_[a_json.size()] = '\0';
+
+            auto& document = document_.emplace(&*values_, kInitialStack, &*stack_);
+            document.template ParseInsitu<ParseFlags>(text_.data());
+            value_capacity_ = NextCapacity(*values_, value_buffer_size_, value_capacity_);
+            stack_capacity_ = NextCapacity(*stack_, stack_buffer_size_, stack_capacity_);
+
+            if (document.HasParseError()) {
+                if constexpr (std::is_same_v<Source, std::filesystem::path>) {
+                    logger::error("Failed to parse {}: {} (offset {})", a_source.string(),
+                                  rapidjson::GetParseError_En(document.GetParseError()), document.GetErrorOffset());
+                } else {
+                    logger::error("Failed to parse {}: {} (offset {})", a_source,
+                                  rapidjson::GetParseError_En(document.GetParseError()), document.GetErrorOffset());
+                }
+                return nullptr;
+            }
+            return &document;
+        }
+
+        // A pool that had to allocate past its buffer gets a buffer that fits this load, plus slack, next time
+        static std::size_t NextCapacity(const Allocator& a_pool, const std::size_t a_buffer_size,
+                                        const std::size_t a_capacity) {
+            if (a_pool.Capacity() <= a_buffer_size) return a_capacity;
+            return std::max(a_capacity, a_pool.Size() + a_pool.Size() / 4);
+        }
+
+        void Reset() {
+            document_.reset();
+
+            // Regrow the backing buffers if the last load outgrew them, otherwise just rewind the pools
+            if (!values_ || value_buffer_size_ < value_capacity_) {
+                values_.reset();
+                value_buffer_ = std::make_unique_for_overwrite<char[]>(value_capacity_);
+                value_buffer_size_ = value_capacity_;
+                values_.emplace(value_buffer_.get(), value_buffer_size_);
+            } else {
+                values_->Clear();
+            }
+            if (!stack_ || stack_buffer_size_ < stack_capacity_) {
+                stack_.reset();
+                stack_buffer_ = std::make_unique_for_overwrite<char[]>(stack_capacity_);
+                stack_buffer_size_ = stack_capacity_;
+                stack_.emplace(stack_buffer_.get(), stack_buffer_size_);
+            } else {
+                stack_->Clear();
+            }
+        }
+
+        std::vector<char> text_;
+        std::unique_ptr<char[]> value_buffer_;
+        std::unique_ptr<char[]> stack_buffer_;
+        std::size_t value_buffer_size_ = 0;
+        std::size_t stack_buffer_size_ = 0;
+        std::size_t value_capacity_;
+        std::size_t stack_capacity_;
+        std::optional<Allocator> values_;
+        std::optional<Allocator> stack_;
+        std::optional<Document> document_;
+    };
+}
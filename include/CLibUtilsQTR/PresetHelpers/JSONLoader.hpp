@@ -0,0 +1,267 @@
+#pragma once
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <rapidjson/error/en.h>
+#include <rapidjson/filereadstream.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+#include "CLibUtilsQTR/FormReaderCache.hpp"
+#include "CLibUtilsQTR/PresetHelpers/Config.hpp"
+
+namespace Presets {
+    /**
+     * @brief Loads Fields straight from the JSON text, without building a rapidjson DOM.
+     *
+     * Fields are bound to dotted paths from the root object (`"spawn.chance"`), by default their key(). The file is
+     * parsed in one pass with rapidjson::Reader; every key is looked up in a table of the bound paths, and subtrees
+     * with nothing bound below them are skipped without being stored. Memory use is the read buffer plus the
+     * deepest path, whatever the file size.
+     *
+     * A bound value is converted with the same rules as Getters::JSON::Get; if that fails, the Field keeps its
+     * value. Paths only go through objects, not into arrays. With duplicate keys the first occurrence is used,
+     * like the DOM lookup.
+     */
+    class JSONLoader {
+    public:
+        template <typename T, typename BlockType>
+        JSONLoader& Bind(Field<T, BlockType>& a_field) {
+            return Bind(a_field.key(), a_field);
+        }
+
+        template <typename T, typename BlockType>
+        JSONLoader& Bind(const std::string_view a_path, Field<T, BlockType>& a_field) {
+            bindings_.insert_or_assign(std::string(a_path), std::make_unique<FieldBinding<T>>(a_field.get()));
+            // Every object on the way to a bound value has to be entered instead of skipped
+            for (auto dot = a_path.find('.'); dot != std::string_view::npos; dot = a_path.find('.', dot + 1)) {
+                prefixes_.emplace(a_path.substr(0, dot));
+            }
+            return *this;
+        }
+
+        template <unsigned ParseFlags = rapidjson::kParseDefaultFlags>
+        bool LoadFile(const std::filesystem::path& a_path) {
+            std::FILE* file = nullptr;
+#ifdef _WIN32
+            if (_wfopen_s(&file, a_path.c_str(), L"rb") != 0) file = nullptr;
+#else
+            file = std::fopen(a_path.c_str(), "rb");
+#endif
+            if (!file) {
+                logger::error("Failed to open {}", a_path.string());
+                return false;
+            }
+
+            char buffer[64 * 1024];
+            rapidjson::FileReadStream stream(file, buffer, sizeof(buffer));
+            const bool ok = Parse<ParseFlags>(stream, a_path.string());
+            std::fclose(file);
+            return ok;
+        }
+
+        template <unsigned ParseFlags = rapidjson::kParseDefaultFlags>
+        bool LoadString(const std::string_view a_json) {
+            rapidjson::MemoryStream stream(a_json.data(), a_json.size());
+            return Parse<ParseFlags>(stream, "<string>");
+        }
+
+        // Fields set by the last load
+        [[nodiscard]] std::size_t loaded() const { return loaded_; }
+
+    private:
+        struct Binding {
+            virtual ~Binding() = default;
+            [[nodiscard]] virtual bool IsVector() const = 0;
+            virtual bool Scalar(const rapidjson::Value& a_value) = 0;  // a whole scalar field, or one vector element
+            virtual void BeginArray() {}
+            virtual bool EndArray() { return false; }
+            virtual void Fail() {}
+
+            bool seen = false;
+        };
+
+        template <typename T>
+        struct FieldBinding final : Binding {
+            explicit FieldBinding(T& a_target) : target(a_target) {}
+
+            [[nodiscard]] bool IsVector() const override { return detail::is_std_vector_v<T>; }
+
+            bool Scalar(const rapidjson::Value& a_value) override {
+                if constexpr (detail::is_std_vector_v<T>) {
+                    typename T::value_type item;
+                    if (!failed && Getters::JSON::GetScalar(a_value, item)) {
+                        pending.push_back(std::move(item));
+                    } else {
+                        failed = true;
+                    }
+                    return false;
+                } else {
+                    T result;
+                    if (!Getters::JSON::GetScalar(a_value, result)) return false;
+                    target = std::move(result);
+                    return true;
+                }
+            }
+
+            void BeginArray() override {
+                if constexpr (detail::is_std_vector_v<T>) {
+                    pending.clear();
+                    failed = false;
+                }
+            }
+
+            bool EndArray() override {
+                if constexpr (detail::is_std_vector_v<T>) {
+                    if (failed) return false;
+                    target = std::move(pending);
+                    pending = T{};
+                    return true;
+                } else {
+                    return false;
+                }
+            }
+
+            void Fail() override { failed = true; }
+
+            T& target;
+            std::conditional_t<detail::is_std_vector_v<T>, T, char> pending{};
+            bool failed = false;
+        };
+
+        // SAX handler: tracks the dotted path of the current value and forwards bound values
+        struct Handler {
+            JSONLoader& loader;
+            std::string path{};
+            std::vector<std::size_t> marks{};  // path length at each open object
+            std::size_t skip = 0;              // depth inside a subtree that is being ignored
+            Binding* array = nullptr;          // bound vector being filled
+            bool started = false;
+
+            Binding* Lookup() const {
+                const auto it = loader.bindings_.find(path);
+                if (it == loader.bindings_.end() || it->second->seen) return nullptr;
+                it->second->seen = true;
+                return it->second.get();
+            }
+
+            bool Value(const rapidjson::Value& a_value) {
+                started = true;
+                if (skip) return true;
+                if (array) {
+                    array->Scalar(a_value);
+                } else if (!marks.empty()) {
+                    if (const auto binding = Lookup(); binding && !binding->IsVector() && binding->Scalar(a_value)) {
+                        ++loader.loaded_;
+                    }
+                }
+                return true;
+            }
+
+            bool Null() { return Value(rapidjson::Value(rapidjson::kNullType)); }
+            bool Bool(const bool b) { return Value(rapidjson::Value(b)); }
+            bool Int(const int i) { return Value(rapidjson::Value(i)); }
+            bool Uint(const unsigned u) { return Value(rapidjson::Value(u)); }
+            bool Int64(const std::int64_t i) { return Value(rapidjson::Value(i)); }
+            bool Uint64(const std::uint64_t u) { return Value(rapidjson::Value(u)); }
+            bool Double(const double d) { return Value(rapidjson::Value(d)); }
+            bool RawNumber(const char* str, const rapidjson::SizeType length, bool) {
+                return Value(rapidjson::Value(str, length));
+            }
+            bool String(const char* str, const rapidjson::SizeType length, bool) {
+                return Value(rapidjson::Value(str, length));
+            }
+
+            bool Key(const char* str, const rapidjson::SizeType length, bool) {
+                if (skip) return true;
+                path.resize(marks.back());
+                if (!path.empty()) path += '.';
+                path.append(str, length);
+                return true;
+            }
+
+            bool StartObject() {
+                if (skip || array) {
+                    if (array) array->Fail();
+                    ++skip;
+                    return true;
+                }
+                if (!started) {
+                    started = true;
+                    marks.push_back(0);
+                    return true;
+                }
+                if (marks.empty()) {
+                    ++skip;
+                    return true;
+                }
+                Lookup();  // a bound value that is an object does not match, and later duplicates are ignored
+                if (loader.prefixes_.contains(path)) {
+                    marks.push_back(path.size());
+                } else {
+                    ++skip;
+                }
+                return true;
+            }
+
+            bool EndObject(rapidjson::SizeType) {
+                if (skip) {
+                    --skip;
+                } else {
+                    marks.pop_back();
+                }
+                return true;
+            }
+
+            bool StartArray() {
+                const bool root = !started;
+                started = true;
+                if (skip || array || root || marks.empty()) {
+                    if (array) array->Fail();
+                    ++skip;
+                    return true;
+                }
+                if (const auto binding = Lookup(); binding && binding->IsVector()) {
+                    array = binding;
+                    array->BeginArray();
+                    return true;
+                }
+                ++skip;
+                return true;
+            }
+
+            bool EndArray(rapidjson::SizeType) {
+                if (skip) {
+                    --skip;
+                } else if (array) {
+                    if (array->EndArray()) ++loader.loaded_;
+                    array = nullptr;
+                }
+                return true;
+            }
+        };
+
+        template <unsigned ParseFlags, typename Stream>
+        bool Parse(Stream& a_stream, const std::string& a_source) {
+            loaded_ = 0;
+            for (const auto& binding : bindings_ | std::views::values) binding->seen = false;
+
+            Handler handler{*this};
+            rapidjson::Reader reader;
+            if (const auto result = reader.Parse<ParseFlags>(a_stream, handler); result.IsError()) {
+                logger::error("Failed to parse {}: {} (offset {})", a_source,
+                              rapidjson::GetParseError_En(result.Code()), result.Offset());
+                return false;
+            }
+            return true;
+        }
+
+        std::unordered_map<std::string, std::unique_ptr<Binding>, FormReader::StringHash, std::equal_to<>> bindings_;
+        std::unordered_set<std::string, FormReader::StringHash, std::equal_to<>> prefixes_;
+        std::size_t loaded_ = 0;
+    };
+}
@@ -0,0 +1,271 @@
+#pragma once
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "CLibUtilsQTR/MappedFile.hpp"
+#include "CLibUtilsQTR/PluginIndex.hpp"
+#include "CLibUtilsQTR/StringHelpers.hpp"
+#include "CLibUtilsQTR/PresetHelpers/Config.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FormGroupsSnapshot.hpp"
+#include "CLibUtilsQTR/PresetHelpers/Schema.hpp"
+
+namespace Presets::Cache {
+    /**
+     * Binary snapshot of a fully loaded schema struct (see Schema.hpp), so that unchanged presets skip parsing and
+     * form resolution on the next launch:
+     *
+     *   Header | payload
+     *
+     * The payload is the struct's members in schema order: arithmetic values raw (bools as a 0/1 byte), strings and
+     * vectors as a 32-bit count followed by their contents (vectors of arithmetic values as one block), nested
+     * structs inline and Fields as their loaded value (the key is not stored, the struct's default member
+     * initializers provide it).
+     * A snapshot is only used if its schema, its source files, the published form groups and the plugin load order
+     * all still match, since FormIDs stored in it depend on the groups the presets named and on the load order.
+     */
+    inline constexpr std::uint32_t kMagic = 0x43525051;  // "QPRC"
+    inline constexpr std::uint32_t kVersion = 1;
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t schema_hash;
+        std::uint64_t source_hash;
+        std::uint64_t load_order_hash;
+        std::uint64_t payload_size;
+    };
+
+    namespace detail {
+        constexpr std::uint64_t Mix(const std::uint64_t a_hash, const std::uint64_t a_value) {
+            return (a_hash ^ a_value) * 1099511628211ull;
+        }
+
+        template <typename T>
+        constexpr std::uint64_t TypeHash();
+
+        template <HasSchema T>
+        constexpr std::uint64_t StructHash() {
+            std::uint64_t hash = StringHelpers::fnv1a("struct");
+            SchemaOf<T>::value.ForEach([&hash](const auto& a_field) {
+                using Member = typename std::remove_cvref_t<decltype(a_field)>::member_type;
+                hash = Mix(StringHelpers::fnv1a(a_field.key, hash), TypeHash<Member>());
+            });
+            return hash;
+        }
+
+        // Changes whenever the binary layout of T changes
+        template <typename T>
+        constexpr std::uint64_t TypeHash() {
+            if constexpr (HasSchema<T>) {
+                return StructHash<T>();
+            } else if constexpr (Presets::detail::is_field_v<T>) {
+                using Value = std::remove_cvref_t<decltype(std::declval<const T&>().get())>;
+                return Mix(StringHelpers::fnv1a("field"), TypeHash<Value>());
+            } else if constexpr (Presets::detail::is_std_vector_v<T>) {
+                return Mix(StringHelpers::fnv1a("vector"), TypeHash<typename T::value_type>());
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                return StringHelpers::fnv1a("string");
+            } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+                return Mix(Mix(StringHelpers::fnv1a("scalar"), sizeof(T)),
+                           (std::is_floating_point_v<T> ? 2 : 0) | (std::is_signed_v<T> ? 1 : 0));
+            } else {
+                static_assert(Getters::always_false_v<T>, "Type cannot be stored in a preset cache");
+                return 0;
+            }
+        }
+
+        class Writer {
+        public:
+            template <typename T>
+            void Write(const T& a_value) {
+                if constexpr (HasSchema<T>) {
+                    SchemaOf<T>::value.ForEach([&](const auto& a_field) { Write(a_value.*a_field.member); });
+                } else if constexpr (Presets::detail::is_field_v<T>) {
+                    Write(a_value.get());
+                } else if constexpr (Presets::detail::is_std_vector_v<T>) {
+                    Count(a_value.size());
+                    using Elem = typename T::value_type;
+                    if constexpr ((std::is_arithmetic_v<Elem> || std::is_enum_v<Elem>) && !std::is_same_v<Elem, bool>) {
+                        Raw(a_value.data(), a_value.size() * sizeof(Elem));
+                    } else {
+                        for (const auto& item : a_value) Write(static_cast<const Elem&>(item));
+                    }
+                } else if constexpr (std::is_same_v<T, std::string>) {
+                    Count(a_value.size());
+                    Raw(a_value.data(), a_value.size());
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    const std::uint8_t byte = a_value ? 1 : 0;
+                    Raw(&byte, sizeof(byte));
+                } else {
+                    Raw(&a_value, sizeof(T));
+                }
+            }
+
+            [[nodiscard]] const std::string& data() const { return data_; }
+
+        private:
+            void Count(const std::size_t a_count) {
+                const auto count = static_cast<std::uint32_t>(a_count);
+                Raw(&count, sizeof(count));
+            }
+
+            void Raw(const void* a_data, const std::size_t a_size) {
+                data_.append(static_cast<const char*>(a_data), a_size);
+            }
+
+            std::string data_;
+        };
+
+        class Reader {
+        public:
+            explicit Reader(const std::string_view a_data) : data_(a_data) {}
+
+            template <typename T>
+            bool Read(T& a_value) {
+                if constexpr (HasSchema<T>) {
+                    bool ok = true;
+                    SchemaOf<T>::value.ForEach([&](const auto& a_field) { ok = ok && Read(a_value.*a_field.member); });
+                    return ok;
+                } else if constexpr (Presets::detail::is_field_v<T>) {
+                    return Read(a_value.get());
+                } else if constexpr (Presets::detail::is_std_vector_v<T>) {
+                    std::uint32_t count = 0;
+                    if (!Raw(&count, sizeof(count))) return false;
+                    using Elem = typename T::value_type;
+                    if constexpr ((std::is_arithmetic_v<Elem> || std::is_enum_v<Elem>) && !std::is_same_v<Elem, bool>) {
+                        if (static_cast<std::size_t>(count) * sizeof(Elem) > data_.size()) return false;
+                        a_value.resize(count);
+                        return Raw(a_value.data(), count * sizeof(Elem));
+                    } else {
+                        T result;
+                        result.reserve(std::min<std::size_t>(count, data_.size()));
+                        for (std::uint32_t i = 0; i < count; ++i) {
+                            Elem item{};
+                            if (!Read(item)) return false;
+                            result.push_back(std::move(item));
+                        }
+                        a_value = std::move(result);
+                        return true;
+                    }
+                } else if constexpr (std::is_same_v<T, std::string>) {
+                    std::uint32_t length = 0;
+                    if (!Raw(&length, sizeof(length)) || length > data_.size()) return false;
+                    a_value.assign(data_.data(), length);
+                    data_.remove_prefix(length);
+                    return true;
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    // Any byte other than 0 is true; copying it into a bool as is would not be a valid bool
+                    std::uint8_t byte = 0;
+                    if (!Raw(&byte, sizeof(byte))) return false;
+                    a_value = byte != 0;
+                    return true;
+                } else {
+                    return Raw(&a_value, sizeof(T));
+                }
+            }
+
+            [[nodiscard]] bool done() const { return data_.empty(); }
+
+        private:
+            bool Raw(void* a_out, const std::size_t a_size) {
+                if (a_size > data_.size()) return false;
+                if (a_size) std::memcpy(a_out, data_.data(), a_size);
+                data_.remove_prefix(a_size);
+                return true;
+            }
+
+            std::string_view data_;
+        };
+    }
+
+    template <HasSchema T>
+    constexpr std::uint64_t SchemaHash() {
+        return detail::Mix(detail::TypeHash<T>(), kVersion);
+    }
+
+    // Hash of the names and contents of the preset source files, in the given order; 0 if one cannot be read
+    inline std::uint64_t HashSources(const std::span<const std::filesystem::path> a_sources) {
+        auto hash = StringHelpers::fnv1a("");
+        for (const auto& path : a_sources) {
+            const clib_utilsQTR::MappedFile file(path);
+            if (!file.is_open()) return 0;
+            hash = StringHelpers::fnv1a(path.filename().string(), hash);
+            hash = StringHelpers::fnv1a(file.view(), hash);
+        }
+        return hash;
+    }
+
+    // Hash of the names and FormIDs of the published form groups, whatever order they were added in; presets naming
+    // a group resolve differently once it changes
+    inline std::uint64_t HashFormGroups(
+        const PresetHelpers::FormGroupsSnapshot& a_groups = PresetHelpers::AcquireFormGroups()) {
+        std::uint64_t sum = 0;
+        if (a_groups) {
+            a_groups->ForEach([&sum](const std::string_view a_name, const std::span<const RE::FormID> a_ids) {
+                const std::string_view bytes(reinterpret_cast<const char*>(a_ids.data()), a_ids.size_bytes());
+                sum += StringHelpers::fnv1a(bytes, StringHelpers::fnv1a(a_name));
+            });
+        }
+        return detail::Mix(StringHelpers::fnv1a("groups"), sum);
+    }
+
+    // Returns false if the snapshot is missing, damaged or stale; a_out is only written on success
+    template <HasSchema T>
+    bool Read(const std::filesystem::path& a_path, const std::uint64_t a_source_hash,
+              const std::uint64_t a_load_order_hash, T& a_out) {
+        const clib_utilsQTR::MappedFile file(a_path);
+        if (!file.is_open()) return false;
+        const auto data = file.view();
+
+        Header header{};
+        if (data.size() < sizeof(Header)) return false;
+        std::memcpy(&header, data.data(), sizeof(Header));
+        if (header.magic != kMagic || header.version != kVersion || header.schema_hash != SchemaHash<T>() ||
+            header.source_hash != a_source_hash || header.load_order_hash != a_load_order_hash ||
+            header.payload_size != data.size() - sizeof(Header)) {
+            return false;
+        }
+
+        T result{};
+        detail::Reader reader(data.substr(sizeof(Header)));
+        if (!reader.Read(result) || !reader.done()) return false;
+        a_out = std::move(result);
+        return true;
+    }
+
+    // Replaces the file atomically, see clib_utilsQTR::WriteFileAtomic
+    template <HasSchema T>
+    bool Write(const std::filesystem::path& a_path, const std::uint64_t a_source_hash,
+               const std::uint64_t a_load_order_hash, const T& a_value) {
+        detail::Writer writer;
+        writer.Write(a_value);
+        const auto& payload = writer.data();
+        const Header header{kMagic, kVersion, SchemaHash<T>(), a_source_hash, a_load_order_hash, payload.size()};
+        return clib_utilsQTR::WriteFileAtomic(a_path,
+                                              {std::as_bytes(std::span(&header, 1)), std::as_bytes(std::span(payload))});
+    }
+
+    /**
+     * @brief Loads a_out from the snapshot if a_sources, the form groups and the load order are unchanged, otherwise
+     * calls `a_compile(T&)` (the normal text path: parse, resolve forms) and stores the result for next time.
+     * @return true if the snapshot was used.
+     */
+    template <HasSchema T, typename Compile>
+    bool LoadCached(const std::filesystem::path& a_cache_path, const std::span<const std::filesystem::path> a_sources,
+                    T& a_out, Compile&& a_compile,
+                    const std::uint64_t a_load_order_hash = FormReader::CurrentLoadOrderHash()) {
+        auto source_hash = HashSources(a_sources);
+        if (source_hash) source_hash = detail::Mix(source_hash, HashFormGroups());
+        if (source_hash && Read(a_cache_path, source_hash, a_load_order_hash, a_out)) return true;
+
+        a_compile(a_out);
+        if (source_hash && !Write(a_cache_path, source_hash, a_load_order_hash, a_out)) {
+            logger::warn("Presets: could not write cache {}", a_cache_path.string());
+        }
+        return false;
+    }
+}
@@ -1,13 +1,10 @@
 #pragma once
 #include <filesystem>
-#include <shared_mutex>
-#include <unordered_map>
-#include <unordered_set>
 #include "CLibUtilsQTR/FormReader.hpp"
 
 namespace PresetHelpers {
     using FormID = FormReader::FormID;
 
-    inline std::shared_mutex formGroups_mutex_;
-    inline std::unordered_map<std::string, std::unordered_set<FormID>> formGroups;
-} // namespace PresetHelpers
\ No newline at end of file
+    // Form groups are stored as published FrozenFormGroups snapshots, not as a mutable map: read them with
+    // FindFormGroup / AcquireFormGroups and change them with EditFormGroups (FormGroupsSnapshot.hpp).
+} // namespace PresetHelpers
@@ -1,36 +1,141 @@
 #pragma once
+#include <chrono>
+#include "CLibUtilsQTR/FormReaderCache.hpp"
+#include "CLibUtilsQTR/MappedFile.hpp"
+#include "CLibUtilsQTR/Parallel.hpp"
 #include "CLibUtilsQTR/StringHelpers.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FormGroupGraph.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FormGroupsSnapshot.hpp"
 #include "CLibUtilsQTR/PresetHelpers/PresetHelpers.hpp"
 
 namespace PresetHelpers::TXT_Helpers {
-    inline void GatherForms(const std::string& folder_path) {
-        if (!std::filesystem::exists(folder_path)) {
-            return;
+    // Wall time of each GatherFormsParallel stage, in milliseconds
+    struct GatherTimings {
+        double read_ms = 0.0;
+        double resolve_ms = 0.0;
+        double merge_ms = 0.0;
+        std::size_t files = 0;
+        std::size_t lines = 0;
+        std::size_t identifiers = 0;  // unique identifiers actually resolved
+    };
+
+    namespace detail {
+        // Lines are views into file, no per-line copies
+        struct GroupFile {
+            std::string name;
+            clib_utilsQTR::MappedFile file;
+            std::vector<std::string_view> lines;
+        };
+
+        // .txt files of the folder, sorted so that every run processes them in the same order
+        inline std::vector<std::filesystem::path> ListGroupFiles(const std::string& folder_path) {
+            std::vector<std::filesystem::path> files;
+            if (!std::filesystem::exists(folder_path)) {
+                return files;
+            }
+            for (const auto& entry : std::filesystem::directory_iterator(folder_path)) {
+                if (!entry.is_regular_file() || entry.path().extension() != ".txt") continue;
+                files.push_back(entry.path());
+            }
+            std::ranges::sort(files);
+            return files;
         }
 
-        for (const auto& entry : std::filesystem::directory_iterator(folder_path)) {
-            if (!entry.is_regular_file() || entry.path().extension() != ".txt") continue;
-            const auto filename = entry.path().string();
+        inline bool ReadGroupFile(const std::filesystem::path& a_path, GroupFile& a_group) {
+            if (!a_group.file.Open(a_path)) {
+                return false;
+            }
 
-            std::ifstream file(filename);
-            if (!file.is_open()) {
-                continue;
+            a_group.name = a_path.stem().string();
+            auto text = a_group.file.view();
+            std::string_view line;
+            while (StringHelpers::next_line(text, line)) {
+                a_group.lines.push_back(line);
             }
+            return true;
+        }
+
+        using clib_utilsQTR::detail::ElapsedMs;
+    }
 
-            const auto file_name_without_extension = entry.path().stem().string();
+    /**
+     * @brief Parallel version of GatherForms with the same result.
+     *
+     * 1. Files are read and split into trimmed lines on worker threads.
+     * 2. Lines naming another group of the folder become includes; every other distinct identifier across all
+     *    files is resolved once, also on worker threads.
+     * 3. Includes are expanded (see FormGroupGraph) off-lock and the closures are published to lock-free readers
+     *    in one EditFormGroups batch.
+     *
+     * @param a_timings Optional per-stage timing breakdown.
+     * @param a_threads Worker threads, 0 for clib_utilsQTR::DefaultThreadCount().
+     * @param a_resolver Callable `FormID(std::string_view)`; called concurrently, so it must be thread-safe.
+     *                   Pass a lambda around FormReader::resolutionCache to share the memoized lookups.
+     */
+    template <typename Resolver = FormReader::GameResolver>
+    void GatherFormsParallel(const std::string& folder_path, GatherTimings* a_timings = nullptr,
+                             const std::size_t a_threads = 0, Resolver a_resolver = {}) {
+        GatherTimings timings;
+        auto start = std::chrono::steady_clock::now();
 
-            formGroups[file_name_without_extension] = {};
+        // 1) read + parse
+        const auto files = detail::ListGroupFiles(folder_path);
+        std::vector<detail::GroupFile> groups(files.size());
+        std::vector<char> opened(files.size(), 0);
+        clib_utilsQTR::ParallelFor(files.size(), [&](const std::size_t i) {
+            opened[i] = detail::ReadGroupFile(files[i], groups[i]);
+        }, a_threads);
+        timings.files = files.size();
+        timings.read_ms = detail::ElapsedMs(start);
 
-            std::string line;
-            while (std::getline(file, line)) {
-                // trim whitespace from the line
-                line = StringHelpers::trim(line);
-                if (line.empty()) continue; // skip empty lines
-                if (auto a_form = FormReader::GetFormEditorIDFromString(line); a_form > 0) {
-                    std::unique_lock lock(formGroups_mutex_);
-                    formGroups.at(file_name_without_extension).insert(a_form);
+        // 2) bulk resolve of the distinct identifiers
+        std::unordered_set<std::string_view> group_names;
+        for (std::size_t i = 0; i < groups.size(); ++i) {
+            if (opened[i]) group_names.insert(groups[i].name);
+        }
+
+        const auto resolved = clib_utilsQTR::detail::ResolveDistinct<FormID>(
+            [&](auto&& a_add) {
+                for (const auto& group : groups) {
+                    timings.lines += group.lines.size();
+                    for (const auto& line : group.lines) {
+                        if (!group_names.contains(line)) a_add(line);
+                    }
+                }
+            },
+            [&a_resolver](const std::string_view a_identifier, FormID& a_formid) { a_formid = a_resolver(a_identifier); },
+            a_threads);
+        timings.identifiers = resolved.size();
+        timings.resolve_ms = detail::ElapsedMs(start);
+
+        // 3) expand includes and build off-lock, publish under one lock
+        FormGroupGraph graph;
+        for (std::size_t i = 0; i < groups.size(); ++i) {
+            if (!opened[i]) continue;
+            std::vector<FormID> forms;
+            std::vector<std::string> includes;
+            for (const auto& line : groups[i].lines) {
+                if (group_names.contains(line)) {
+                    includes.emplace_back(line);
+                } else if (const auto form = resolved.at(line); form > 0) {
+                    forms.push_back(form);
                 }
             }
+            graph.Set(groups[i].name, std::move(forms), std::move(includes));
         }
+        graph.Update();
+        EditFormGroups([&](FormGroupsEditor& a_editor) {
+            for (std::size_t i = 0; i < groups.size(); ++i) {
+                if (opened[i]) a_editor.Set(groups[i].name, graph.Closure(groups[i].name));
+            }
+        });
+        timings.merge_ms = detail::ElapsedMs(start);
+
+        if (a_timings) *a_timings = timings;
+    }
+
+    // Sequential GatherForms: same staged loader (including nested groups) on the calling thread
+    inline void GatherForms(const std::string& folder_path) {
+        GatherFormsParallel(folder_path, nullptr, 1);
     }
-}
\ No newline at end of file
+}
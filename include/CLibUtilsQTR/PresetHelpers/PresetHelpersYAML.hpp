@@ -2,31 +2,40 @@
 #include <shared_mutex>
 #include "CLibUtilsQTR/StringHelpers.hpp"
 #include "CLibUtilsQTR/PresetHelpers/PresetHelpers.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FormGroupExpressions.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FormGroupsSnapshot.hpp"
 #include "CLibUtilsQTR/FormReader.hpp"
 #include "yaml-cpp/yaml.h"
+#include "CLibUtilsQTR/PresetHelpers/GettersYAML.hpp"
 
 namespace PresetHelpers::YAML_Helpers {
-    inline std::vector<FormID> StringToFormIDs(const std::string& input) {
-        if (std::shared_lock lock(formGroups_mutex_);
-            formGroups.contains(input)) {
-            auto& temp = formGroups.at(input);
-            return std::vector<FormID>(temp.begin(), temp.end());
-        }
+    using PresetHelpers::AppendFormIDs;
 
-        if (FormID a_formid = FormReader::GetFormEditorIDFromString(input); a_formid > 0) {
-            return {a_formid};
+    inline std::vector<FormID> StringToFormIDs(const std::string_view input) {
+        std::vector<FormID> res;
+        AppendFormIDs(input, res);
+        return res;
+    }
+
+    // Converts with Presets::Getters::YAML where it can; anything else (or unparsable) still goes through as<T>()
+    template <typename T>
+    T ScalarAs(const YAML::Node& node) {
+        if constexpr (Presets::Getters::YAML::is_scalar_v<T>) {
+            if (T value{}; Presets::Getters::YAML::GetScalar(node, value)) return value;
         }
-        return {};
+        return node.as<T>();
     }
 
     template <typename T>
     std::vector<T> CollectFrom(const YAML::Node& node, const std::string& key) {
         auto res = std::vector<T>{};
-        if (node[key].IsScalar()) {
-            res.push_back(node[key].as<T>());
+        const auto values = node[key];
+        if (values.IsScalar()) {
+            res.push_back(ScalarAs<T>(values));
         } else {
-            for (const auto& value : node[key]) {
-                res.push_back(value.as<T>());
+            res.reserve(values.size());
+            for (const auto& value : values) {
+                res.push_back(ScalarAs<T>(value));
             }
         }
         return res;
@@ -38,13 +47,13 @@ namespace PresetHelpers::YAML_Helpers {
     template <>
     inline std::vector<FormID> CollectFrom<FormID, std::string>(const YAML::Node& node, const std::string& key) {
         auto res = std::vector<FormID>{};
-        if (node[key].IsScalar()) {
-            auto temp = StringToFormIDs(node[key].as<std::string>());
-            res.insert(res.end(), temp.begin(), temp.end());
+        const auto values = node[key];
+        if (values.IsScalar()) {
+            AppendFormIDs(values.Scalar(), res);
         } else {
-            for (const auto& iterator_value : node[key]) {
-                auto temp = StringToFormIDs(iterator_value.as<std::string>());
-                res.insert(res.end(), temp.begin(), temp.end());
+            for (const auto& iterator_value : values) {
+                AppendFormIDs(iterator_value.IsScalar() ? iterator_value.Scalar() : iterator_value.as<std::string>(),
+                              res);
             }
         }
         return res;
@@ -0,0 +1,192 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "CLibUtilsQTR/FormReaderCache.hpp"
+#include "CLibUtilsQTR/MappedFile.hpp"
+#include "CLibUtilsQTR/Parallel.hpp"
+#include "CLibUtilsQTR/StringHelpers.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FormGroupExpressions.hpp"
+
+namespace Presets {
+    using FormID = FormReader::FormID;
+
+    // Handle to a form identifier recorded while parsing, resolved before the merge
+    struct FormRequest {
+        std::uint32_t index = 0;
+    };
+
+    // Default resolver of LoadPresets: a group, a group expression or a single identifier, see AppendFormIDs
+    struct FormSetResolver {
+        void operator()(const std::string_view a_identifier, std::vector<FormID>& a_out) const {
+            PresetHelpers::AppendFormIDs(a_identifier, a_out);
+        }
+    };
+
+    /**
+     * @brief Form identifiers one preset file needs.
+     *
+     * Parsing runs on worker threads and must not touch the game, so instead of resolving an identifier on the spot
+     * the parser records it with Request() and keeps the handle. By the time the file is merged every request has
+     * been resolved: GetAll() returns the FormIDs it stands for (a whole group or expression, or one form) and Get()
+     * the first of them (0 if it did not resolve).
+     */
+    class FormRequests {
+    public:
+        FormRequest Request(const std::string_view a_identifier) {
+            identifiers_.emplace_back(a_identifier);
+            return {static_cast<std::uint32_t>(identifiers_.size() - 1)};
+        }
+
+        [[nodiscard]] std::span<const FormID> GetAll(const FormRequest a_request) const {
+            if (a_request.index >= ranges_.size()) return {};
+            const auto [offset, count] = ranges_[a_request.index];
+            return std::span<const FormID>(ids_).subspan(offset, count);
+        }
+
+        [[nodiscard]] FormID Get(const FormRequest a_request) const {
+            const auto ids = GetAll(a_request);
+            return ids.empty() ? 0 : ids.front();
+        }
+
+        [[nodiscard]] std::string_view Identifier(const FormRequest a_request) const {
+            return identifiers_[a_request.index];
+        }
+
+        [[nodiscard]] const std::vector<std::string>& identifiers() const { return identifiers_; }
+        [[nodiscard]] std::size_t size() const { return identifiers_.size(); }
+
+        // a_lookup: `std::span<const FormID>(std::string_view identifier)`
+        template <typename Lookup>
+        void Resolve(Lookup&& a_lookup) {
+            ids_.clear();
+            ranges_.clear();
+            ranges_.reserve(identifiers_.size());
+            for (const auto& identifier : identifiers_) {
+                const std::span<const FormID> ids = a_lookup(std::string_view(identifier));
+                ranges_.push_back({static_cast<std::uint32_t>(ids_.size()), static_cast<std::uint32_t>(ids.size())});
+                ids_.insert(ids_.end(), ids.begin(), ids.end());
+            }
+        }
+
+    private:
+        struct Range {
+            std::uint32_t offset;
+            std::uint32_t count;
+        };
+
+        std::vector<std::string> identifiers_;
+        std::vector<FormID> ids_;
+        std::vector<Range> ranges_;
+    };
+
+    struct LoadStats {
+        std::size_t files = 0;
+        std::size_t failed = 0;       // could not be read or the parser rejected them
+        std::size_t identifiers = 0;  // distinct identifiers resolved
+        double parse_ms = 0.0;
+        double resolve_ms = 0.0;
+        double merge_ms = 0.0;
+    };
+
+    // Files of the folder with one of the extensions (".json", ".yaml", ...), sorted by name
+    inline std::vector<std::filesystem::path> ListPresetFiles(const std::filesystem::path& a_folder,
+                                                              const std::initializer_list<std::string_view> a_extensions) {
+        std::vector<std::filesystem::path> files;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(a_folder, ec)) {
+            if (!entry.is_regular_file()) continue;
+            const auto extension = entry.path().extension().string();
+            for (const auto wanted : a_extensions) {
+                if (StringHelpers::iequals(extension, wanted)) {
+                    files.push_back(entry.path());
+                    break;
+                }
+            }
+        }
+        std::ranges::sort(files);
+        return files;
+    }
+
+    /**
+     * @brief Loads many independent preset files concurrently with the same outcome as loading them one by one.
+     *
+     * 1. Every file is read and handed to a_parse on a worker thread:
+     *    `bool(const std::filesystem::path&, std::string_view contents, Result&, FormRequests&)`.
+     *    Returning false (or throwing) drops the file. The parser only fills its own Result.
+     * 2. The form identifiers requested by all files are resolved in bulk, each distinct one once, in parallel.
+     * 3. a_merge is called on the calling thread for each parsed file, in the order of a_files:
+     *    `void(const std::filesystem::path&, Result&, const FormRequests&)`.
+     *    Later files therefore override earlier ones exactly as in a sequential loop over a_files.
+     *
+     * @param a_files Files in priority order, e.g. from ListPresetFiles or sorted by plugin load order.
+     * @param a_threads Worker threads, 0 for clib_utilsQTR::DefaultThreadCount().
+     * @param a_resolver Callable `void(std::string_view, std::vector<FormID>&)` appending the forms of an identifier,
+     *                   or `FormID(std::string_view)` for single forms only; called concurrently, so it must be
+     *                   thread-safe. The default resolves groups and expressions like CollectFrom<FormID, std::string>.
+     */
+    template <typename Result, typename Parse, typename Merge, typename Resolver = FormSetResolver>
+    LoadStats LoadPresets(const std::span<const std::filesystem::path> a_files, Parse&& a_parse, Merge&& a_merge,
+                          const std::size_t a_threads = 0, Resolver a_resolver = {}) {
+        LoadStats stats;
+        stats.files = a_files.size();
+        auto start = std::chrono::steady_clock::now();
+
+        // 1) read + parse
+        std::vector<Result> results(a_files.size());
+        std::vector<FormRequests> requests(a_files.size());
+        std::vector<char> parsed(a_files.size(), 0);
+        clib_utilsQTR::ParallelFor(a_files.size(), [&](const std::size_t i) {
+            try {
+                const clib_utilsQTR::MappedFile file(a_files[i]);
+                if (!file.is_open()) {
+                    logger::error("Failed to open {}", a_files[i].string());
+                    return;
+                }
+                parsed[i] = a_parse(a_files[i], file.view(), results[i], requests[i]);
+            } catch (const std::exception& e) {
+                logger::error("Failed to load {}: {}", a_files[i].string(), e.what());
+            }
+        }, a_threads);
+        stats.failed = static_cast<std::size_t>(std::ranges::count(parsed, 0));
+        stats.parse_ms = clib_utilsQTR::detail::ElapsedMs(start);
+
+        // 2) bulk resolve
+        const auto resolved = clib_utilsQTR::detail::ResolveDistinct<std::vector<FormID>>(
+            [&](auto&& a_add) {
+                for (std::size_t i = 0; i < a_files.size(); ++i) {
+                    if (!parsed[i]) continue;
+                    for (const auto& identifier : requests[i].identifiers()) a_add(identifier);
+                }
+            },
+            [&a_resolver](const std::string_view a_identifier, std::vector<FormID>& a_ids) {
+                if constexpr (std::is_invocable_r_v<FormID, Resolver&, std::string_view>) {
+                    if (const FormID formid = a_resolver(a_identifier); formid > 0) a_ids.push_back(formid);
+                } else {
+                    a_resolver(a_identifier, a_ids);
+                }
+            },
+            a_threads);
+        for (std::size_t i = 0; i < a_files.size(); ++i) {
+            if (!parsed[i]) continue;
+            requests[i].Resolve([&resolved](const std::string_view a_identifier) -> std::span<const FormID> {
+                return resolved.at(a_identifier);
+            });
+        }
+        stats.identifiers = resolved.size();
+        stats.resolve_ms = clib_utilsQTR::detail::ElapsedMs(start);
+
+        // 3) deterministic merge
+        for (std::size_t i = 0; i < a_files.size(); ++i) {
+            if (parsed[i]) a_merge(a_files[i], results[i], std::as_const(requests[i]));
+        }
+        stats.merge_ms = clib_utilsQTR::detail::ElapsedMs(start);
+        return stats;
+    }
+}
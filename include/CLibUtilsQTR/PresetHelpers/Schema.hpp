@@ -0,0 +1,137 @@
+#pragma once
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "CLibUtilsQTR/StringHelpers.hpp"
+#include "CLibUtilsQTR/PresetHelpers/Config.hpp"
+#include "CLibUtilsQTR/PresetHelpers/Getters.hpp"
+
+namespace Presets {
+    namespace detail {
+        template <typename T>
+        struct is_field : std::false_type {};
+
+        template <typename T, typename BlockType>
+        struct is_field<Field<T, BlockType>> : std::true_type {};
+
+        template <typename T>
+        inline constexpr bool is_field_v = is_field<T>::value;
+    }
+
+    // One struct member bound to a key; the key is not copied anywhere
+    template <typename Class, typename Member>
+    struct SchemaField {
+        using class_type = Class;
+        using member_type = Member;
+
+        std::string_view key;
+        Member Class::* member;
+        std::uint64_t hash;
+    };
+
+    template <typename Class, typename Member>
+    consteval SchemaField<Class, Member> Key(const std::string_view a_key, Member Class::* a_member) {
+        return {a_key, a_member, StringHelpers::fnv1a(a_key)};
+    }
+
+    /**
+     * @brief Compile-time table of the members of a preset struct and their keys.
+     *
+     * @code
+     * struct Spawn {
+     *     int chance = 5;
+     *     std::vector<std::string> items;
+     *     Limits limits;  // has a schema of its own
+     *
+     *     static constexpr auto schema = Presets::Schema{
+     *         Presets::Key("chance", &Spawn::chance),
+     *         Presets::Key("items", &Spawn::items),
+     *         Presets::Key("limits", &Spawn::limits),
+     *     };
+     * };
+     * @endcode
+     * A member may also be a Field; its value is read and cached like a plain member, under the schema's key (the
+     * Field's own key is not used).
+     * Alternatively specialize Presets::SchemaOf<Spawn> with a `static constexpr auto value`.
+     */
+    template <typename... Fields>
+    struct Schema {
+        std::tuple<Fields...> fields;
+
+        constexpr explicit Schema(Fields... a_fields) : fields(a_fields...) {}
+
+        static constexpr std::size_t size() { return sizeof...(Fields); }
+
+        template <typename Func>
+        constexpr void ForEach(Func&& a_func) const {
+            std::apply([&](const auto&... a_field) { (a_func(a_field), ...); }, fields);
+        }
+    };
+
+    template <typename T>
+    struct SchemaOf;
+
+    template <typename T>
+        requires requires { T::schema; }
+    struct SchemaOf<T> {
+        static constexpr const auto& value = T::schema;
+    };
+
+    template <typename T>
+    concept HasSchema = requires { SchemaOf<T>::value; };
+
+    namespace Getters::JSON {
+        template <HasSchema T>
+        bool GetStruct(const rapidjson::Value& a_object, T& a_out);
+
+        // Nested schema structs, Fields and vectors of anything readable recurse, everything else is a GetScalar
+        template <typename T>
+        bool GetMember(const rapidjson::Value& a_value, T& a_out) {
+            if constexpr (HasSchema<T>) {
+                return GetStruct(a_value, a_out);
+            } else if constexpr (Presets::detail::is_field_v<T>) {
+                return GetMember(a_value, a_out.get());
+            } else if constexpr (detail::is_std_vector_v<T>) {
+                if (!a_value.IsArray()) return false;
+                const auto& arr = a_value.GetArray();
+                T result;
+                result.reserve(arr.Size());
+                for (const auto& item : arr) {
+                    typename T::value_type temp{};
+                    if (!GetMember(item, temp)) return false;
+                    result.push_back(std::move(temp));
+                }
+                a_out = std::move(result);
+                return true;
+            } else {
+                return GetScalar(a_value, a_out);
+            }
+        }
+
+        /**
+         * @brief Fills a schema struct from a JSON object in a single walk over the object's members.
+         *
+         * Each member name is hashed once and matched against the precomputed key hashes; matching values are
+         * written straight into the struct. Missing keys and values of the wrong type leave the member unchanged.
+         * @return false if a_object is not an object.
+         */
+        template <HasSchema T>
+        bool GetStruct(const rapidjson::Value& a_object, T& a_out) {
+            if (!a_object.IsObject()) return false;
+            constexpr const auto& schema = SchemaOf<T>::value;
+            for (auto it = a_object.MemberBegin(); it != a_object.MemberEnd(); ++it) {
+                const std::string_view name(it->name.GetString(), it->name.GetStringLength());
+                const auto hash = StringHelpers::fnv1a(name);
+                std::apply(
+                    [&](const auto&... a_field) {
+                        (void)((a_field.hash == hash && a_field.key == name &&
+                                (GetMember(it->value, a_out.*a_field.member), true)) ||
+                               ...);
+                    },
+                    schema.fields);
+            }
+            return true;
+        }
+    }
+}
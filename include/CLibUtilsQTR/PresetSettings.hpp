@@ -2,13 +2,36 @@
 // Year: 2025
 
 #pragma once
+#include "CLibUtilsQTR/PresetBlock.hpp"
 
 namespace clib_utilsQTR {
+    template <std::size_t S>
+    struct PresetPool;
+
+    // Type-erased node of a PresetPool's registry, so the pool can switch settings of any value type
+    class PresetSettingBase {
+    public:
+        virtual void apply_level(std::size_t lvl) = 0;
+
+    protected:
+        PresetSettingBase() = default;
+        ~PresetSettingBase() = default;
+
+    private:
+        template <std::size_t S>
+        friend struct PresetPool;
+
+        PresetSettingBase* prev_ = nullptr;
+        PresetSettingBase* next_ = nullptr;
+    };
+
     template <std::size_t S>
     struct PresetPool {
-        size_t current = 0;
         std::array<std::string_view, S> names;
 
+        // Level index of a setting whose value does not match any of its levels
+        static constexpr std::size_t kCustom = S;
+
         explicit constexpr PresetPool(std::array<std::string_view, S> n) : names(n) {
         }
 
@@ -18,44 +41,131 @@ namespace clib_utilsQTR {
             if (idx < kTotal) {
                 return names[idx];
             }
+            if (idx == kCustom) {
+                return "Custom";
+            }
             return "Unknown";
         }
+
+        // Level last switched to with apply(); safe to call from any thread while another one applies
+        [[nodiscard]] std::size_t current() const { return active_.Get(&Active::level); }
+
+        // Switches every setting of this pool to lvl in one pass over the registry, then publishes lvl as current()
+        void apply(const std::size_t lvl) const {
+            if (lvl >= kTotal) {
+                return;
+            }
+            detail::FlagLock lock(lock_);
+            for (auto* setting = head_; setting; setting = setting->next_) {
+                setting->apply_level(lvl);
+            }
+            active_.Update([lvl](Active& a_active) { a_active.level = lvl; });
+        }
+
+        void link(PresetSettingBase* a_setting) const {
+            detail::FlagLock lock(lock_);
+            a_setting->prev_ = nullptr;
+            a_setting->next_ = head_;
+            if (head_) {
+                head_->prev_ = a_setting;
+            }
+            head_ = a_setting;
+        }
+
+        void unlink(PresetSettingBase* a_setting) const {
+            detail::FlagLock lock(lock_);
+            if (a_setting->prev_) {
+                a_setting->prev_->next_ = a_setting->next_;
+            } else if (head_ == a_setting) {
+                head_ = a_setting->next_;
+            }
+            if (a_setting->next_) {
+                a_setting->next_->prev_ = a_setting->prev_;
+            }
+            a_setting->prev_ = a_setting->next_ = nullptr;
+        }
+
+    private:
+        struct Active {
+            std::size_t level = 0;
+        };
+
+        // atomic_flag and PresetBlock instead of std::mutex keep the pool a literal type, so it can stay constexpr
+        mutable PresetSettingBase* head_ = nullptr;
+        mutable std::atomic_flag lock_;
+        mutable PresetBlock<Active> active_;
     };
 
+    /**
+     * @brief Setting with one value per level of the pool P.
+     *
+     * The value and its level are published together through a PresetBlock, so any thread can read them while
+     * another one assigns or the pool applies a level, and always gets a value with its matching level. Writes go
+     * through operator= and set_level() only; there is no mutable reference to the value.
+     */
     template <typename T, std::size_t S, const PresetPool<S>& P>
-    struct PresetSetting {
-        T current;
+        requires std::is_trivially_copyable_v<T>
+    struct PresetSetting : PresetSettingBase {
+        // Published value and the level it belongs to
+        struct State {
+            T value;
+            std::size_t level;
+        };
+
         std::array<T, S> level_values;
 
         explicit PresetSetting(const std::array<T, S>& levels)
-            : current(levels[0]), level_values(levels) {
+            : level_values(levels), state_(State{levels[0], 0}) {
+            P.link(this);
         }
 
         explicit PresetSetting(const T& value)
-            : current(value), level_values{make_level_values(value)} {
+            : level_values{make_level_values(value)}, state_(State{value, 0}) {
+            P.link(this);
+        }
+
+        PresetSetting(const PresetSetting& other)
+            : level_values(other.level_values), state_(other.state_.Read()) {
+            P.link(this);
+        }
+
+        PresetSetting& operator=(const PresetSetting& other) {
+            level_values = other.level_values;
+            state_.Store(other.state_.Read());
+            return *this;
         }
 
+        ~PresetSetting() { P.unlink(this); }
+
         PresetSetting& operator=(const T& value) {
-            current = value;
+            state_.Store(State{value, find_level(value)});
             return *this;
         }
 
         // ReSharper disable once CppNonExplicitConversionOperator
-        operator const T&() const { return current; }
-        // ReSharper disable once CppNonExplicitConversionOperator
-        operator T&() { return current; }
+        operator T() const { return get(); }
+
+        [[nodiscard]] T get() const { return state_.Get(&State::value); }
 
+        // Value and level from the same publish
+        [[nodiscard]] State read() const { return state_.Read(); }
 
         [[nodiscard]] const T& for_level(std::size_t lvl) const { return level_values[lvl]; }
-        void set_level(const std::size_t lvl) { current = level_values[lvl]; }
+
+        void set_level(const std::size_t lvl) { state_.Store(State{level_values[lvl], lvl}); }
+
+        void apply_level(const std::size_t lvl) override { set_level(lvl); }
 
         PresetSetting& operator=(const std::size_t lvl) {
             set_level(lvl);
             return *this;
         }
 
+        // Index of the current level, PresetPool<S>::kCustom if the value matches none
+        [[nodiscard]] std::size_t level() const { return state_.Get(&State::level); }
+
         [[nodiscard]] std::string_view name() const {
-            return P.to_name(current_lvl());
+            return P.to_name(level());
         }
 
     private:
@@ -65,14 +175,15 @@ namespace clib_utilsQTR {
             return result;
         }
 
-        [[nodiscard]] size_t current_lvl() const {
+        [[nodiscard]] size_t find_level(const T& a_value) const {
             for (size_t i = 0; i < S; ++i) {
-                if (level_values[i] == current) {
+                if (level_values[i] == a_value) {
                     return i;
                 }
             }
-            set_level(0);
-            return 0;
+            return PresetPool<S>::kCustom;
         }
+
+        PresetBlock<State> state_;
     };
-}
\ No newline at end of file
+}
@@ -1,6 +1,14 @@
 #pragma once
+#include <array>
+#include <bit>
+#include <cstring>
+#include <functional>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace SKSE {
     class SerializationInterface;
@@ -12,12 +20,12 @@ namespace Serialization {
     template <typename T, typename U>
     class BaseData {
     public:
-        float GetData(T formId, T missing) {
+        U GetData(T formId, U missing) {
             Locker locker(m_Lock);
             // if the plugin version is less than 0.7 need to handle differently
             // if (SKSE::PluginInfo::version)
-            if (auto idx = m_Data.contains(formId)) {
-                return m_Data[formId];
+            if (const auto it = m_Data.find(formId); it != m_Data.end()) {
+                return it->second;
             }
             return missing;
         }
@@ -80,35 +88,207 @@ namespace Serialization {
         return decodedString;
     }
 
+    /**
+     * @brief Drop-in alternative to BaseData for data read from many threads at once, e.g. per-actor values queried
+     * every frame.
+     *
+     * Keys are spread over Shards independent open-addressing tables (linear probing), each behind its own
+     * std::shared_mutex: readers of the same shard share the lock and readers of different shards never touch the
+     * same cache line. Since there is no single m_Data to lock, Save implementations iterate with ForEach.
+     */
+    template <typename T, typename U, std::size_t Shards = 16>
+        requires(std::has_single_bit(Shards))
+    class ShardedBaseData {
+    public:
+        U GetData(T formId, U missing) const {
+            const auto hash = Hash(formId);
+            const auto& shard = ShardOf(hash);
+            std::shared_lock lock(shard.mutex);
+            if (const auto* slot = shard.Find(formId, hash)) {
+                return slot->value;
+            }
+            return missing;
+        }
+
+        void SetData(T formId, U value) {
+            const auto hash = Hash(formId);
+            auto& shard = ShardOf(hash);
+            std::unique_lock lock(shard.mutex);
+            shard.Insert(formId, std::move(value), hash);
+        }
+
+        virtual const char* GetType() = 0;
+
+        virtual bool Save(SKSE::SerializationInterface*, std::uint32_t,
+                          std::uint32_t) { return false; }
+
+        virtual bool Save(SKSE::SerializationInterface*) { return false; }
+        virtual bool Load(SKSE::SerializationInterface*) { return false; }
+
+        void Clear() {
+            for (auto& shard : m_Shards) {
+                std::unique_lock lock(shard.mutex);
+                shard.slots.clear();
+                shard.count = 0;
+            }
+        }
+
+        // a_func: `void(const T&, const U&)`; each shard is read-locked while it is visited
+        template <typename Func>
+        void ForEach(Func&& a_func) const {
+            for (const auto& shard : m_Shards) {
+                std::shared_lock lock(shard.mutex);
+                for (const auto& slot : shard.slots) {
+                    if (slot.used) {
+                        a_func(slot.key, slot.value);
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            std::size_t total = 0;
+            for (const auto& shard : m_Shards) {
+                std::shared_lock lock(shard.mutex);
+                total += shard.count;
+            }
+            return total;
+        }
+
+    protected:
+        ~ShardedBaseData() = default;
+
+    private:
+        struct Slot {
+            T key{};
+            U value{};
+            bool used = false;
+        };
+
+        struct alignas(64) Shard {
+            std::vector<Slot> slots;  // power-of-two size, kept at most 3/4 full
+            std::size_t count = 0;
+            mutable std::shared_mutex mutex;
+
+            const Slot* Find(const T& a_key, const std::uint64_t a_hash) const {
+                if (slots.empty()) return nullptr;
+                const auto mask = slots.size() - 1;
+                for (auto i = static_cast<std::size_t>(a_hash) & mask;; i = (i + 1) & mask) {
+                    const auto& slot = slots[i];
+                    if (!slot.used) return nullptr;
+                    if (slot.key == a_key) return &slot;
+                }
+            }
+
+            void Insert(const T& a_key, U&& a_value, const std::uint64_t a_hash) {
+                if ((count + 1) * 4 > slots.size() * 3) {
+                    Grow();
+                }
+                const auto mask = slots.size() - 1;
+                for (auto i = static_cast<std::size_t>(a_hash) & mask;; i = (i + 1) & mask) {
+                    auto& slot = slots[i];
+                    if (!slot.used) {
+                        slot = {a_key, std::move(a_value), true};
+                        ++count;
+                        return;
+                    }
+                    if (slot.key == a_key) {
+                        slot.value = std::move(a_value);
+                        return;
+                    }
+                }
+            }
+
+            void Grow() {
+                auto old = std::move(slots);
+                slots = std::vector<Slot>(old.empty() ? 16 : old.size() * 2);
+                count = 0;
+                for (auto& slot : old) {
+                    if (slot.used) {
+                        Insert(slot.key, std::move(slot.value), Hash(slot.key));
+                    }
+                }
+            }
+        };
+
+        // The top bits pick the shard, the low bits the slot within it
+        static std::uint64_t Hash(const T& a_key) {
+            auto h = static_cast<std::uint64_t>(std::hash<T>{}(a_key));
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            return h;
+        }
+
+        static constexpr std::size_t ShardIndex(const std::uint64_t a_hash) {
+            if constexpr (Shards == 1) {
+                return 0;
+            } else {
+                return static_cast<std::size_t>(a_hash >> (64 - std::countr_zero(Shards)));
+            }
+        }
+
+        Shard& ShardOf(const std::uint64_t a_hash) { return m_Shards[ShardIndex(a_hash)]; }
+        const Shard& ShardOf(const std::uint64_t a_hash) const { return m_Shards[ShardIndex(a_hash)]; }
+
+        std::array<Shard, Shards> m_Shards;
+    };
+
+    /**
+     * Strings are stored as a size_t header followed by the raw bytes. Version 2 sets kStringV2Tag in the header
+     * and keeps the length in the remaining bits. The legacy format (one std::pair<int, bool> per character, at most
+     * 100 of them) stored a plain count there, so read_string can tell both apart and still loads old saves.
+     * Lengths above kMaxStringLength are rejected on both sides, so a damaged header never turns into a huge
+     * allocation.
+     */
+    inline constexpr std::size_t kStringV2Tag = 1ull << 63;
+    inline constexpr std::size_t kMaxStringLength = 1 << 20;
+
+    namespace detail {
+        inline bool read_legacy_string(SKSE::SerializationInterface* a_intfc, const std::size_t a_size,
+                                       std::string& a_str) {
+            if (a_size > kMaxStringLength) {
+                return false;
+            }
+            std::vector<std::pair<int, bool>> encodedStr(a_size);
+            const auto bytes = static_cast<std::uint32_t>(a_size * sizeof(std::pair<int, bool>));
+            if (a_intfc->ReadRecordData(encodedStr.data(), bytes) != bytes) {
+                return false;
+            }
+            a_str = decodeString(encodedStr);
+            return true;
+        }
+    }
+
     inline bool read_string(SKSE::SerializationInterface* a_intfc, std::string& a_str) {
-        std::vector<std::pair<int, bool>> encodedStr;
         std::size_t size;
         if (!a_intfc->ReadRecordData(size)) {
             return false;
         }
-        for (std::size_t i = 0; i < size; i++) {
-            std::pair<int, bool> temp_pair;
-            if (!a_intfc->ReadRecordData(temp_pair)) {
-                return false;
-            }
-            encodedStr.push_back(temp_pair);
+        if (!(size & kStringV2Tag)) {
+            return detail::read_legacy_string(a_intfc, size, a_str);
         }
-        a_str = decodeString(encodedStr);
-        return true;
-    }
 
-    inline bool write_string(SKSE::SerializationInterface* a_intfc, const std::string& a_str) {
-        const auto encodedStr = encodeString(a_str);
-        // i first need the size to know no of iterations
-        const auto size = encodedStr.size();
-        if (!a_intfc->WriteRecordData(size)) {
+        const auto length = size & ~kStringV2Tag;
+        if (length > kMaxStringLength) {
+            logger::error("Serialized string length {} exceeds the limit, record is damaged", length);
             return false;
         }
-        for (const auto& temp_pair : encodedStr) {
-            if (!a_intfc->WriteRecordData(temp_pair)) {
-                return false;
-            }
+        a_str.resize(length);
+        return length == 0 ||
+               a_intfc->ReadRecordData(a_str.data(), static_cast<std::uint32_t>(length)) == length;
+    }
+
+    // Header and bytes go out in a single WriteRecordData call
+    inline bool write_string(SKSE::SerializationInterface* a_intfc, const std::string_view a_str) {
+        if (a_str.size() > kMaxStringLength) {
+            logger::error("String too long to serialize ({} bytes)", a_str.size());
+            return false;
         }
-        return true;
-    };
+        const std::size_t header = kStringV2Tag | a_str.size();
+        std::string record(sizeof(header) + a_str.size(), '\0');
+        std::memcpy(record.data(), &header, sizeof(header));
+        std::memcpy(record.data() + sizeof(header), a_str.data(), a_str.size());
+        return a_intfc->WriteRecordData(record.data(), static_cast<std::uint32_t>(record.size()));
+    }
 }
\ No newline at end of file
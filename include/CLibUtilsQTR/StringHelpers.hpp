@@ -1,6 +1,36 @@
 #pragma once
 
 namespace StringHelpers {
+    // FNV-1a over the raw bytes; constexpr so keys can be computed at compile time
+    constexpr std::uint64_t fnv1a(const std::string_view a_str, std::uint64_t a_hash = 14695981039346656037ull) {
+        for (const char c : a_str) {
+            a_hash ^= static_cast<unsigned char>(c);
+            a_hash *= 1099511628211ull;
+        }
+        return a_hash;
+    }
+
+    constexpr char toLowerASCII(const char c) {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    // Case-insensitive (ASCII) FNV-1a, e.g. for plugin filenames
+    constexpr std::uint64_t fnv1a_ci(const std::string_view a_str, std::uint64_t a_hash = 14695981039346656037ull) {
+        for (const char c : a_str) {
+            a_hash ^= static_cast<unsigned char>(toLowerASCII(c));
+            a_hash *= 1099511628211ull;
+        }
+        return a_hash;
+    }
+
+    constexpr bool iequals(const std::string_view a_lhs, const std::string_view a_rhs) {
+        if (a_lhs.size() != a_rhs.size()) return false;
+        for (std::size_t i = 0; i < a_lhs.size(); ++i) {
+            if (toLowerASCII(a_lhs[i]) != toLowerASCII(a_rhs[i])) return false;
+        }
+        return true;
+    }
+
     template <typename T>
     std::string join(const T& container, const std::string_view& delimiter) {
         std::ostringstream oss;
@@ -32,6 +62,24 @@ namespace StringHelpers {
         return str.substr(start, end - start + 1);
     }
 
+    constexpr std::string_view trim_view(const std::string_view str) {
+        const size_t start = str.find_first_not_of(" \t\n\r");
+        if (start == std::string_view::npos) return {};
+        const size_t end = str.find_last_not_of(" \t\n\r");
+        return str.substr(start, end - start + 1);
+    }
+
+    // Pops the next trimmed, non-empty line off the front of a_text. Returns false once a_text is exhausted.
+    constexpr bool next_line(std::string_view& a_text, std::string_view& a_line) {
+        while (!a_text.empty()) {
+            const auto eol = a_text.find('\n');
+            a_line = trim_view(a_text.substr(0, eol));
+            a_text.remove_prefix(eol == std::string_view::npos ? a_text.size() : eol + 1);
+            if (!a_line.empty()) return true;
+        }
+        return false;
+    }
+
     inline std::string toLowercase(const std::string& str) {
         std::string result = str;
         std::ranges::transform(result, result.begin(),
@@ -3,13 +3,34 @@
 #include "Animations.hpp"
 #include "BoundingBox.hpp"
 #include "DrawDebug.hpp"
+#include "EditorIDIndex.hpp"
+#include "FormBatchConverter.hpp"
+#include "FormLiteral.hpp"
 #include "FormReader.hpp"
+#include "FormReaderCache.hpp"
+#include "MappedFile.hpp"
 #include "Papyrus.hpp"
+#include "Parallel.hpp"
+#include "PluginIndex.hpp"
+#include "PresetBlock.hpp"
 #include "PresetSettings.hpp"
 #include "Serialization.hpp"
 #include "StringHelpers.hpp"
 #include "Tasker.hpp"
 #include "Ticker.hpp"
 #include "PresetHelpers/Config.hpp"
+#include "PresetHelpers/GettersYAML.hpp"
+#include "PresetHelpers/FormGroupExpressions.hpp"
+#include "PresetHelpers/FormGroupGraph.hpp"
+#include "PresetHelpers/FormGroupsCache.hpp"
+#include "PresetHelpers/FormGroupsReverseIndex.hpp"
+#include "PresetHelpers/FormGroupsSnapshot.hpp"
+#include "PresetHelpers/FormGroupsReloader.hpp"
+#include "PresetHelpers/FrozenFormGroups.hpp"
+#include "PresetHelpers/JSONLoadContext.hpp"
+#include "PresetHelpers/JSONLoader.hpp"
+#include "PresetHelpers/PresetCache.hpp"
 #include "PresetHelpers/PresetHelpersTXT.hpp"
+#include "PresetHelpers/PresetPipeline.hpp"
 #include "PresetHelpers/PresetHelpersYAML.hpp"
+#include "PresetHelpers/Schema.hpp"
@@ -0,0 +1,55 @@
+#include "CLibUtilsQTR/FormReader.hpp"
+#include "Catch.h"
+
+TEST_CASE("EditorIDIndex answers single and batch queries", "[EditorIDIndex]") {
+    const std::vector<FormReader::EditorIDIndex::Record> records{
+        {0x00013989, "IronDagger"},
+        {0x00012EB7, "IronSword"},
+        {0x00013790, "SteelDagger"},
+        {0x00012EB7, "Duplicate"},  // the first record of an id wins
+        {0x00000014, ""},           // forms without an EditorID are not indexed
+    };
+    FormReader::EditorIDIndex index;
+    CHECK(index.Get(0x00012EB7).empty());
+    index.Build(records);
+    REQUIRE(index.size() == 3);
+
+    CHECK(index.Get(0x00012EB7) == "IronSword");
+    CHECK(index.Get(0x00000014).empty());
+    CHECK(index.Get(0x00099999).empty());
+    // Names keep the case they were built with, so callers comparing them case-insensitively get a match
+    CHECK(StringHelpers::iequals(index.Get(0x00013790), "steeldagger"));
+    CHECK(index.Get(0x00013790) != "steeldagger");
+
+    const std::vector<RE::FormID> sorted{0x00000001, 0x00012EB7, 0x00013790, 0x00013989, 0x00020000};
+    const std::vector<RE::FormID> unsorted{0x00013989, 0x00000001, 0x00012EB7};
+    CHECK(index.Get(sorted) ==
+          std::vector<std::string_view>{"", "IronSword", "SteelDagger", "IronDagger", ""});
+    CHECK(index.Get(unsorted) == std::vector<std::string_view>{"IronDagger", "", "IronSword"});
+
+    std::vector<RE::FormID> walked;
+    index.ForEach([&](const RE::FormID a_id, std::string_view) { walked.push_back(a_id); });
+    CHECK(walked == std::vector<RE::FormID>{0x00012EB7, 0x00013790, 0x00013989});
+}
+
+TEST_CASE("EditorIDIndex rebuilds from the loaded forms", "[EditorIDIndex]") {
+    TestGame::Reset();
+    TestGame::AddForm(0x00012EB7, "IronSword");
+    TestGame::AddForm(0x00013989, "IronDagger");
+
+    FormReader::EditorIDIndex index;
+    index.BuildFromForms();
+    CHECK(index.size() == 2);
+    const auto before = index.Get(0x00012EB7);
+
+    TestGame::AddForm(0xFF000800, "RuntimeForm");
+    index.BuildFromForms();
+    CHECK(index.size() == 3);
+    CHECK(index.Get(0xFF000800) == "RuntimeForm");
+    CHECK(before == "IronSword");  // views survive the next rebuild
+
+    TestGame::Reset();
+    index.BuildFromForms();
+    CHECK(index.size() == 0);
+    CHECK(index.Get(0x00012EB7).empty());
+}
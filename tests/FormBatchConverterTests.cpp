@@ -0,0 +1,66 @@
+#include "CLibUtilsQTR/FormBatchConverter.hpp"
+#include "Catch.h"
+
+namespace {
+    // Mix of master, plugin and light ids, malformed lines and blank lines
+    std::string MakeExport(const std::size_t a_lines) {
+        std::string text;
+        char line[16];
+        for (std::size_t i = 0; i < a_lines; ++i) {
+            const auto id = i % 3 == 0 ? 0x01000000 + i : i % 3 == 1 ? 0x0A000000 + i : 0xFE012000 + (i & 0xFFF);
+            std::snprintf(line, sizeof(line), "%08zX\n", id);
+            text += line;
+            if (i % 997 == 0) text += "not an id\n\n";
+        }
+        text += "0A00FFFF";  // no trailing newline
+        return text;
+    }
+
+    // What the sequential processInput(std::string, std::string) loop produces
+    std::string ConvertSequentially(const std::string_view a_text, const std::string& a_plugin) {
+        std::string out;
+        for (const auto line : std::views::split(a_text, '\n')) {
+            const auto result = FormReader::processInput(std::string(line.begin(), line.end()), a_plugin);
+            if (result.error) continue;
+            out += result.output;
+            out += '\n';
+        }
+        return out;
+    }
+}
+
+TEST_CASE("ConvertBuffer matches processInput line by line", "[FormBatchConverter]") {
+    const auto input = MakeExport(20000);
+    const auto expected = ConvertSequentially(input, "My Plugin.esp");
+
+    for (const std::size_t threads : {1, 3, 8}) {
+        std::string output;
+        FormReader::BatchOptions options;
+        options.threads = threads;
+        const auto stats = FormReader::ConvertBuffer(
+            input, "My Plugin.esp", [&output](const std::string_view a_text) { output += a_text; }, options);
+
+        CHECK(output == expected);
+        CHECK(stats.converted == 20001);
+        CHECK(stats.errors == 21);
+        CHECK(stats.lines == stats.converted + stats.errors);
+    }
+}
+
+TEST_CASE("ConvertFile carries partial lines across chunks", "[FormBatchConverter]") {
+    const auto input = MakeExport(50000);
+    const auto dir = std::filesystem::temp_directory_path() / "clibutilsqtr_tests";
+    std::filesystem::create_directories(dir);
+    const auto in_path = dir / "export.txt";
+    const auto out_path = dir / "converted.txt";
+    std::ofstream(in_path, std::ios::binary) << input;
+
+    FormReader::BatchOptions options;
+    options.chunk_size = 4096;  // forces many chunk boundaries in the middle of lines
+    const auto stats = FormReader::ConvertFile(in_path, out_path, "My Plugin.esp", options);
+
+    std::ifstream converted(out_path, std::ios::binary);
+    const std::string output((std::istreambuf_iterator<char>(converted)), std::istreambuf_iterator<char>());
+    CHECK(output == ConvertSequentially(input, "My Plugin.esp"));
+    CHECK(stats.converted == 50001);
+}
@@ -0,0 +1,31 @@
+#include "CLibUtilsQTR/PresetHelpers/FormGroupExpressions.hpp"
+#include "Catch.h"
+
+TEST_CASE("Expression results follow group edits", "[FormGroupExpressions]") {
+    using namespace PresetHelpers;
+    SetFormGroup("ExprA", {1, 2, 3});
+    SetFormGroup("ExprB", {2});
+
+    FormExpressionCache cache;
+    std::vector<FormID> out;
+    REQUIRE(cache.Evaluate("ExprA - ExprB", out));
+    CHECK(out == std::vector<FormID>{1, 3});
+
+    SetFormGroup("ExprB", {3});
+    out.clear();
+    REQUIRE(cache.Evaluate("ExprA - ExprB", out));
+    CHECK(out == std::vector<FormID>{1, 2});
+}
+
+TEST_CASE("Expression cache stays bounded", "[FormGroupExpressions]") {
+    using namespace PresetHelpers;
+    SetFormGroup("ExprC", {5});
+
+    FormExpressionCache cache;
+    std::vector<FormID> out;
+    for (std::size_t i = 0; i <= FormExpressionCache::kMaxEntries; ++i) {
+        cache.Evaluate("ExprC + Missing" + std::to_string(i), out);
+    }
+    CHECK(cache.size() <= FormExpressionCache::kMaxEntries);
+    CHECK(out.size() == FormExpressionCache::kMaxEntries + 1);
+}
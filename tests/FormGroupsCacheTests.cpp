@@ -0,0 +1,80 @@
+#include "CLibUtilsQTR/PresetHelpers/FormGroupsCache.hpp"
+#include "Catch.h"
+
+namespace {
+    namespace cache = PresetHelpers::TXT_Helpers::cache;
+
+    std::filesystem::path FreshDir(const std::string_view a_name) {
+        const auto dir = std::filesystem::temp_directory_path() / "clibutilsqtr_tests" / a_name;
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+
+    std::vector<RE::FormID> Group(const std::string_view a_name) {
+        const auto group = PresetHelpers::FindFormGroup(a_name);
+        return group ? std::vector(group->begin(), group->end()) : std::vector<RE::FormID>{};
+    }
+}
+
+TEST_CASE("Group snapshot is rejected once a group file changes", "[FormGroupsCache]") {
+    TestGame::Reset();
+    TestGame::AddForm(0x00012EB7, "IronSword");
+    TestGame::AddForm(0x00013989, "IronDagger");
+
+    const auto dir = FreshDir("groups_cache");
+    const auto groups = dir / "groups";
+    const auto snapshot = dir / "groups.bin";
+    std::filesystem::create_directories(groups);
+    std::ofstream(groups / "Weapons.txt") << "IronSword\n";
+
+    using PresetHelpers::TXT_Helpers::GatherFormsCached;
+    CHECK_FALSE(GatherFormsCached(groups.string(), snapshot, nullptr, 1));
+    PresetHelpers::SetFormGroup("OtherFolder", {0x00013989});
+    CHECK(GatherFormsCached(groups.string(), snapshot, nullptr, 1));
+    CHECK(Group("Weapons") == std::vector<RE::FormID>{0x00012EB7});
+    CHECK(Group("OtherFolder") == std::vector<RE::FormID>{0x00013989});  // the snapshot only replaces its own groups
+
+    CHECK_FALSE(GatherFormsCached(groups.string(), snapshot, nullptr, 2));  // load order changed
+
+    std::ofstream(groups / "Weapons.txt", std::ios::app) << "IronDagger\n";
+    CHECK_FALSE(GatherFormsCached(groups.string(), snapshot, nullptr, 2));
+    CHECK(Group("Weapons") == std::vector<RE::FormID>{0x00012EB7, 0x00013989});
+
+    // Same content written again: a new mtime alone invalidates the snapshot
+    CHECK(GatherFormsCached(groups.string(), snapshot, nullptr, 2));
+    std::filesystem::last_write_time(groups / "Weapons.txt",
+                                     std::filesystem::last_write_time(groups / "Weapons.txt") + std::chrono::seconds(5));
+    CHECK_FALSE(GatherFormsCached(groups.string(), snapshot, nullptr, 2));
+}
+
+TEST_CASE("Group snapshot with impossible counts is rejected", "[FormGroupsCache]") {
+    const auto dir = FreshDir("groups_cache_corrupt");
+    const auto snapshot = dir / "groups.bin";
+
+    PresetHelpers::FrozenFormGroups groups;
+    const std::vector<RE::FormID> ids{1, 2, 3};
+    groups.Add("Weapons", ids);
+    REQUIRE(cache::Write(snapshot, {}, 7, groups));
+
+    PresetHelpers::FrozenFormGroups read;
+    REQUIRE(cache::Read(snapshot, {}, 7, read));
+
+    const auto corrupt = [&](const auto a_member, const auto a_value) {
+        std::fstream file(snapshot, std::ios::in | std::ios::out | std::ios::binary);
+        cache::Header header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.*a_member = a_value;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    };
+
+    corrupt(&cache::Header::id_count, std::uint64_t{1} << 62);  // would wrap offset arithmetic
+    CHECK_FALSE(cache::Read(snapshot, {}, 7, read));
+    corrupt(&cache::Header::id_count, std::uint64_t{3});
+    corrupt(&cache::Header::group_count, std::uint32_t{0xFFFFFFFF});
+    CHECK_FALSE(cache::Read(snapshot, {}, 7, read));
+    corrupt(&cache::Header::group_count, std::uint32_t{1});
+    corrupt(&cache::Header::names_size, std::uint64_t{1000});
+    CHECK_FALSE(cache::Read(snapshot, {}, 7, read));
+}
@@ -0,0 +1,141 @@
+#include "CLibUtilsQTR/PresetHelpers/FormGroupsReloader.hpp"
+#include "Catch.h"
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#endif
+
+namespace {
+    std::filesystem::path FreshDir(const std::string_view a_name) {
+        const auto dir = std::filesystem::temp_directory_path() / "clibutilsqtr_tests" / a_name;
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+
+    // Writes the file and moves its mtime forward, so a rewrite within the clock's resolution is still noticed
+    void WriteGroup(const std::filesystem::path& a_path, const std::string_view a_contents) {
+        const bool existed = std::filesystem::exists(a_path);
+        const auto before = existed ? std::filesystem::last_write_time(a_path) : std::filesystem::file_time_type{};
+        std::ofstream(a_path, std::ios::binary | std::ios::trunc) << a_contents;
+        if (existed) std::filesystem::last_write_time(a_path, before + std::chrono::seconds(1));
+    }
+
+    std::vector<RE::FormID> Group(const std::string_view a_name) {
+        const auto group = PresetHelpers::FindFormGroup(a_name);
+        return group ? std::vector(group->begin(), group->end()) : std::vector<RE::FormID>{};
+    }
+
+    void AddForms() {
+        TestGame::Reset();
+        TestGame::AddForm(0x00012EB7, "IronSword");
+        TestGame::AddForm(0x00013989, "IronDagger");
+        TestGame::AddForm(0x00013790, "SteelDagger");
+    }
+}
+
+TEST_CASE("Reloader picks up added, modified and removed files", "[FormGroupsReloader]") {
+    AddForms();
+    const auto dir = FreshDir("reloader_files");
+    WriteGroup(dir / "ReloadA.txt", "IronSword\n");
+
+    PresetHelpers::TXT_Helpers::FormGroupsReloader reloader(dir.string());
+    auto stats = reloader.Reload();
+    CHECK(stats.added == 1);
+    CHECK(Group("ReloadA") == std::vector<RE::FormID>{0x00012EB7});
+
+    // Nothing changed: nothing republished
+    const auto version = PresetHelpers::FormGroupsVersion();
+    stats = reloader.Reload();
+    CHECK(stats.added + stats.changed + stats.removed + stats.republished == 0);
+    CHECK(PresetHelpers::FormGroupsVersion() == version);
+
+    WriteGroup(dir / "ReloadB.txt", "IronDagger\nSteelDagger\n");
+    stats = reloader.Reload();
+    CHECK(stats.added == 1);
+    CHECK(stats.republished == 1);
+    CHECK(Group("ReloadB") == std::vector<RE::FormID>{0x00013790, 0x00013989});
+    CHECK(Group("ReloadA") == std::vector<RE::FormID>{0x00012EB7});
+
+    WriteGroup(dir / "ReloadA.txt", "SteelDagger\n");
+    stats = reloader.Reload();
+    CHECK(stats.changed == 1);
+    CHECK(Group("ReloadA") == std::vector<RE::FormID>{0x00013790});
+
+    std::filesystem::remove(dir / "ReloadB.txt");
+    stats = reloader.Reload();
+    CHECK(stats.removed == 1);
+    CHECK_FALSE(PresetHelpers::FindFormGroup("ReloadB"));
+    CHECK(Group("ReloadA") == std::vector<RE::FormID>{0x00013790});
+}
+
+TEST_CASE("Reloader recomputes groups whose include closure changed", "[FormGroupsReloader]") {
+    AddForms();
+    const auto dir = FreshDir("reloader_includes");
+    WriteGroup(dir / "ReloadInner.txt", "IronSword\n");
+    WriteGroup(dir / "ReloadOuter.txt", "ReloadInner\nIronDagger\n");
+
+    PresetHelpers::TXT_Helpers::FormGroupsReloader reloader(dir.string());
+    reloader.Reload();
+    CHECK(Group("ReloadOuter") == std::vector<RE::FormID>{0x00012EB7, 0x00013989});
+
+    // Only the included file changes; the including group follows
+    WriteGroup(dir / "ReloadInner.txt", "SteelDagger\n");
+    auto stats = reloader.Reload();
+    CHECK(stats.changed == 1);
+    CHECK(stats.republished == 2);
+    CHECK(Group("ReloadOuter") == std::vector<RE::FormID>{0x00013790, 0x00013989});
+
+    // Removing the included file turns the line back into an (unknown) identifier
+    std::filesystem::remove(dir / "ReloadInner.txt");
+    stats = reloader.Reload();
+    CHECK(stats.removed == 1);
+    CHECK(Group("ReloadOuter") == std::vector<RE::FormID>{0x00013989});
+
+    // A new file named like an existing line becomes an include
+    WriteGroup(dir / "ReloadInner.txt", "IronSword\n");
+    stats = reloader.Reload();
+    CHECK(stats.added == 1);
+    CHECK(Group("ReloadOuter") == std::vector<RE::FormID>{0x00012EB7, 0x00013989});
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Reloader does not trust a file whose stat fails", "[FormGroupsReloader]") {
+    AddForms();
+    const auto dir = FreshDir("reloader_stat");
+    const auto path = dir / "ReloadStat.txt";
+    WriteGroup(path, "IronSword\n");
+
+    PresetHelpers::TXT_Helpers::FormGroupsReloader reloader(dir.string());
+    reloader.Reload();
+    REQUIRE(Group("ReloadStat") == std::vector<RE::FormID>{0x00012EB7});
+
+    // An mtime far outside file_time_type's range makes last_write_time report an error
+    const auto break_stat = [&path] {
+        const timespec times[2]{{0, UTIME_OMIT}, {std::numeric_limits<std::int64_t>::max() / 2, 0}};
+        REQUIRE(::utimensat(AT_FDCWD, path.c_str(), times, 0) == 0);
+        std::error_code ec;
+        (void)std::filesystem::last_write_time(path, ec);
+        REQUIRE(ec);
+    };
+
+    // Same size as before, so only the content hash can tell
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "IronDagger\n";
+    break_stat();
+    auto stats = reloader.Reload();
+    CHECK(stats.changed == 1);
+    CHECK(Group("ReloadStat") == std::vector<RE::FormID>{0x00013989});
+
+    // Still failing and unchanged: re-read, but not republished
+    stats = reloader.Reload();
+    CHECK(stats.changed == 0);
+    CHECK(stats.republished == 0);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "SteelDagger\n";
+    break_stat();
+    stats = reloader.Reload();
+    CHECK(stats.changed == 1);
+    CHECK(Group("ReloadStat") == std::vector<RE::FormID>{0x00013790});
+}
+#endif
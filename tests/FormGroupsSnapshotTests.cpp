@@ -0,0 +1,112 @@
+#include "CLibUtilsQTR/PresetHelpers/FormGroupGraph.hpp"
+#include "CLibUtilsQTR/PresetHelpers/FormGroupsSnapshot.hpp"
+#include "Catch.h"
+
+namespace {
+    std::vector<RE::FormID> Group(const std::string_view a_name) {
+        const auto group = PresetHelpers::FindFormGroup(a_name);
+        return group ? std::vector(group->begin(), group->end()) : std::vector<RE::FormID>{};
+    }
+}
+
+TEST_CASE("Edits after the first publish are visible to lookups", "[FormGroupsSnapshot]") {
+    using namespace PresetHelpers;
+    SetFormGroup("SnapshotA", {3, 1, 2});
+    REQUIRE(Group("SnapshotA") == std::vector<FormID>{1, 2, 3});
+
+    SetFormGroup("SnapshotA", {4});
+    CHECK(Group("SnapshotA") == std::vector<FormID>{4});
+
+    CHECK(EraseFormGroup("SnapshotA"));
+    CHECK_FALSE(FindFormGroup("SnapshotA"));
+    CHECK_FALSE(EraseFormGroup("SnapshotA"));
+
+    // In-place edits start from the published group and are frozen when the batch ends
+    SetFormGroup("SnapshotSet", {7, 8});
+    EditFormGroups([](FormGroupsEditor& a_editor) {
+        a_editor["SnapshotSet"].erase(7);
+        a_editor["SnapshotSet"].insert(9);
+        a_editor["SnapshotNew"].insert(1);
+        CHECK(a_editor.Get("SnapshotSet").size() == 2);  // reads as it was when opened
+        CHECK(a_editor.Contains("SnapshotNew"));
+    });
+    CHECK(Group("SnapshotSet") == std::vector<FormID>{8, 9});
+    CHECK(Group("SnapshotNew") == std::vector<FormID>{1});
+}
+
+TEST_CASE("Publishing shares the groups that did not change", "[FormGroupsSnapshot]") {
+    using namespace PresetHelpers;
+    EditFormGroups([](FormGroupsEditor& a_editor) {
+        a_editor.Set("SnapshotKept", {10, 11});
+        a_editor.Set("SnapshotEdited", {20});
+    });
+    const auto before = AcquireFormGroups();
+    const auto version = FormGroupsVersion();
+
+    EditFormGroups([](FormGroupsEditor& a_editor) { a_editor.Erase("SnapshotMissing"); });  // nothing changed
+    CHECK(FormGroupsVersion() == version);
+    CHECK(AcquireFormGroups() == before);
+
+    EditFormGroups([](FormGroupsEditor& a_editor) { a_editor["SnapshotEdited"].insert(21); });
+    const auto after = AcquireFormGroups();
+    REQUIRE(after != before);
+    CHECK(FormGroupsVersion() == version + 1);
+    CHECK(after->Get("SnapshotKept").data() == before->Get("SnapshotKept").data());
+    CHECK(after->Get("SnapshotEdited").data() != before->Get("SnapshotEdited").data());
+    CHECK(Group("SnapshotEdited") == std::vector<FormID>{20, 21});
+    CHECK(before->size() == after->size());
+}
+
+TEST_CASE("Lookups never lock or publish", "[FormGroupsSnapshot]") {
+    using namespace PresetHelpers;
+    SetFormGroup("SnapshotLocked", {5});
+
+    // Would deadlock if the lookup path took the writer lock
+    EditFormGroups([](FormGroupsEditor& a_editor) {
+        a_editor.Set("SnapshotLocked", {6});
+        CHECK(Group("SnapshotLocked") == std::vector<FormID>{5});
+    });
+    CHECK(Group("SnapshotLocked") == std::vector<FormID>{6});
+}
+
+TEST_CASE("Published groups are the arrays that were handed in", "[FormGroupsSnapshot]") {
+    using namespace PresetHelpers;
+    FormGroupGraph graph;
+    graph.Set("SnapshotInner", {3, 1}, {});
+    graph.Set("SnapshotOuter", {2}, {"SnapshotInner"});
+    graph.Update();
+    EditFormGroups([&](FormGroupsEditor& a_editor) {
+        a_editor.Set("SnapshotInner", graph.Closure("SnapshotInner"));
+        a_editor.Set("SnapshotOuter", graph.Closure("SnapshotOuter"));
+    });
+
+    // One copy of each closure, shared by the graph and the snapshot
+    const auto published = AcquireFormGroups();
+    CHECK(published->Get("SnapshotOuter").data() == graph.Closure("SnapshotOuter")->data());
+    CHECK(Group("SnapshotOuter") == std::vector<FormID>{1, 2, 3});
+}
+
+TEST_CASE("Readers see an edit batch whole or not at all", "[FormGroupsSnapshot]") {
+    using namespace PresetHelpers;
+    SetFormGroup("SnapshotPairA", {0});
+    SetFormGroup("SnapshotPairB", {0});
+
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> torn{0};
+    std::jthread reader([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            const auto snapshot = AcquireFormGroups();
+            if (snapshot->Get("SnapshotPairA")[0] != snapshot->Get("SnapshotPairB")[0]) ++torn;
+        }
+    });
+    for (FormID i = 1; i <= 2000; ++i) {
+        EditFormGroups([i](FormGroupsEditor& a_editor) {
+            a_editor.Set("SnapshotPairA", {i});
+            a_editor.Set("SnapshotPairB", {i});
+        });
+    }
+    done = true;
+    reader.join();
+    CHECK(torn == 0);
+    CHECK(Group("SnapshotPairB") == std::vector<FormID>{2000});
+}
@@ -0,0 +1,92 @@
+#include "CLibUtilsQTR/FormReaderCache.hpp"
+#include "CLibUtilsQTR/PresetHelpers/PresetHelpersTXT.hpp"
+#include "Catch.h"
+
+TEST_CASE("EditorIDs resolve from views that are not null-terminated", "[FormReader]") {
+    TestGame::Reset();
+    TestGame::AddForm(0x00012EB7, "IronSword");
+    TestGame::AddForm(0x00013989, "IronDagger");
+
+    // Views in the middle of a larger buffer, as produced by next_line over a mapped file
+    const std::string buffer = "Header\nIronSword\nIronDagger";
+    const std::string_view middle = std::string_view(buffer).substr(7, 9);
+    const std::string_view last = std::string_view(buffer).substr(17);
+    REQUIRE(middle == "IronSword");
+    REQUIRE(last == "IronDagger");
+
+    CHECK(FormReader::GetFormEditorIDFromString(middle) == 0x00012EB7);
+    CHECK(FormReader::GetFormEditorIDFromString(last) == 0x00013989);
+    CHECK(FormReader::GetFormByID<RE::TESForm>(0, middle) != nullptr);
+
+    // The cache trims and passes a view of the trimmed key to the game resolver
+    FormReader::ResolutionCache<> cache;
+    CHECK(cache.Resolve(std::string_view(buffer).substr(6, 11)) == 0x00012EB7);  // "\nIronSword\n"
+}
+
+TEST_CASE("Group files resolve EditorID lines from the mapped file", "[FormReader]") {
+    TestGame::Reset();
+    TestGame::AddForm(0x00012EB7, "IronSword");
+    TestGame::AddForm(0x00013989, "IronDagger");
+
+    const auto dir = std::filesystem::temp_directory_path() / "clibutilsqtr_tests" / "groups_editorid";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "Weapons.txt", std::ios::binary) << "IronSword\r\n  IronDagger";  // no final newline
+
+    PresetHelpers::TXT_Helpers::GatherFormsParallel(dir.string());
+
+    const auto group = PresetHelpers::FindFormGroup("Weapons");
+    REQUIRE(group);
+    CHECK(std::vector(group->begin(), group->end()) == std::vector<RE::FormID>{0x00012EB7, 0x00013989});
+}
+
+TEST_CASE("ResolutionCache memoizes hits, misses and unknown identifiers", "[FormReaderCache]") {
+    std::size_t calls = 0;
+    FormReader::ResolutionCache cache([&calls](const std::string_view a_identifier) -> RE::FormID {
+        ++calls;
+        return a_identifier == "IronSword" ? 0x00012EB7 : 0;
+    });
+
+    CHECK(cache.Resolve(" IronSword ") == 0x00012EB7);
+    CHECK(cache.Resolve("IronSword") == 0x00012EB7);
+    CHECK(cache.Resolve("Unknown") == 0);
+    CHECK(cache.Resolve("Unknown") == 0);
+    CHECK(cache.Resolve("   ") == 0);
+    CHECK(calls == 2);
+
+    const auto stats = cache.Stats();
+    CHECK(stats.hits == 2);
+    CHECK(stats.misses == 2);
+    CHECK(stats.size == 2);
+
+    cache.Invalidate();
+    CHECK(cache.Stats().size == 0);
+    CHECK(cache.Resolve("IronSword") == 0x00012EB7);
+    CHECK(calls == 3);
+
+    SKSE::MessagingInterface::Message message{};
+    message.type = SKSE::MessagingInterface::kPreLoadGame;
+    cache.HandleMessage(&message);
+    CHECK(cache.Stats().size == 0);
+}
+
+TEST_CASE("ResolutionCache drops results of lookups that raced an Invalidate", "[FormReaderCache]") {
+    // The backend invalidates while the first lookup is in flight, as a load-order change on another thread would
+    std::function<void()> during_lookup;
+    RE::FormID answer = 0x00000001;
+    FormReader::ResolutionCache cache([&](std::string_view) {
+        const auto result = answer;
+        if (during_lookup) std::exchange(during_lookup, nullptr)();
+        return result;
+    });
+
+    during_lookup = [&] {
+        cache.Invalidate();
+        answer = 0x00000002;
+    };
+    CHECK(cache.Resolve("Moved") == 0x00000001);
+    CHECK(cache.Stats().size == 0);
+    CHECK(cache.Resolve("Moved") == 0x00000002);
+    CHECK(cache.Resolve("Moved") == 0x00000002);
+    CHECK(cache.Stats().size == 1);
+}
@@ -0,0 +1,58 @@
+#include "CLibUtilsQTR/PresetHelpers/GettersYAML.hpp"
+#include "Catch.h"
+
+namespace {
+    // GetScalar must accept exactly what as<T>() accepts, with the same value
+    template <typename T>
+    void CheckMatchesAs(const std::string& a_text) {
+        INFO(a_text);
+        const auto node = YAML::Load(a_text);
+        std::optional<T> expected;
+        try {
+            expected = node.as<T>();
+        } catch (const YAML::Exception&) {}
+
+        T value{};
+        const bool parsed = Presets::Getters::YAML::GetScalar(node, value);
+        REQUIRE(parsed == expected.has_value());
+        if (!parsed) return;
+        if constexpr (std::is_floating_point_v<T>) {
+            if (std::isnan(*expected)) {
+                CHECK(std::isnan(value));
+                return;
+            }
+        }
+        CHECK(value == *expected);
+    }
+}
+
+TEST_CASE("YAML integers follow yaml-cpp's conversion", "[GettersYAML]") {
+    for (const std::string text : {"010", "0x10", "0X1f", "+5", "0o17", "-12", "0", "00", "08", "0x", "-0x10", "+-5",
+                                   "0x-5", "12 ", "99999999999", "-1", "1e3", "abc"}) {
+        CheckMatchesAs<int>(text);
+        CheckMatchesAs<std::uint32_t>(text);
+        CheckMatchesAs<std::int8_t>(text);
+        CheckMatchesAs<std::int64_t>(text);
+    }
+
+    int value = 0;
+    CHECK(Presets::Getters::YAML::GetScalar(YAML::Load("010"), value));
+    CHECK(value == 8);
+    CHECK_FALSE(Presets::Getters::YAML::GetScalar(YAML::Load("0o17"), value));
+}
+
+TEST_CASE("YAML floats follow yaml-cpp's conversion", "[GettersYAML]") {
+    for (const std::string text : {"1.5", "-1.5", "+1.5", ".5", "-.5", "1.", "1e3", "1E-3", "+1e+3", "010", "0x10",
+                                   "inf", "-inf", "nan", "NaN", "infinity", "Infinity", "+inf", ".inf", "-.Inf",
+                                   "+.INF", ".nan", ".NaN", "+-1", "-+1", "--1", "+", "-", ".", "1e", "1.5.5",
+                                   "1e999", "abc", "1,5"}) {
+        CheckMatchesAs<float>(text);
+        CheckMatchesAs<double>(text);
+    }
+
+    double value = 0.0;
+    CHECK(Presets::Getters::YAML::GetScalar(YAML::Load("-.5"), value));
+    CHECK(value == -0.5);
+    CHECK_FALSE(Presets::Getters::YAML::GetScalar(YAML::Load("inf"), value));
+    CHECK_FALSE(Presets::Getters::YAML::GetScalar(YAML::Load("+-1"), value));
+}
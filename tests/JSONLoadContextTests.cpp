@@ -0,0 +1,90 @@
+#include "CLibUtilsQTR/PresetHelpers/JSONLoadContext.hpp"
+#include <new>
+#include "Catch.h"
+
+namespace {
+    thread_local std::size_t allocations = 0;
+
+    std::filesystem::path FreshDir(const std::string_view a_name) {
+        const auto dir = std::filesystem::temp_directory_path() / "clibutilsqtr_tests" / a_name;
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+
+    template <typename Func>
+    std::size_t CountAllocations(Func&& a_func) {
+        const auto before = allocations;
+        a_func();
+        return allocations - before;
+    }
+
+    std::string Entries(const std::size_t a_count) {
+        std::string json = R"({"entries": [)";
+        for (std::size_t i = 0; i < a_count; ++i) {
+            json += (i ? "," : "") + std::string(R"({"name": "Entry)") + std::to_string(i) + R"(", "weight": )" +
+                    std::to_string(i % 10) + "}";
+        }
+        return json + "]}";
+    }
+}
+
+// Counts every heap allocation of the calling thread, for the no-allocation checks below
+void* operator new(const std::size_t a_size) {
+    ++allocations;
+    if (void* p = std::malloc(a_size ? a_size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* a_ptr) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::size_t) noexcept { std::free(a_ptr); }
+
+TEST_CASE("JSONLoadContext reuses its buffers across loads", "[JSONLoadContext]") {
+    const auto dir = FreshDir("json_load_context");
+    std::ofstream(dir / "small.json") << Entries(2);
+    std::ofstream(dir / "large.json") << Entries(2000);
+    std::ofstream(dir / "broken.json") << R"({"entries": [)";
+
+    Presets::JSONLoadContext context(256, 256);
+    const auto* small = context.Load(dir / "small.json");
+    REQUIRE(small);
+    CHECK((*small)["entries"].Size() == 2);
+
+    const auto* large = context.Load(dir / "large.json");
+    REQUIRE(large);
+    CHECK((*large)["entries"].Size() == 2000);
+    const auto value_capacity = context.value_capacity();
+    CHECK(value_capacity >= 256);
+
+    // Once grown to the largest document, later loads keep the same buffers and still see their own contents
+    for (int i = 0; i < 3; ++i) {
+        const auto* again = context.Load(dir / (i % 2 ? "small.json" : "large.json"));
+        REQUIRE(again);
+        CHECK((*again)["entries"].Size() == (i % 2 ? 2u : 2000u));
+        CHECK(context.value_capacity() == value_capacity);
+    }
+    const std::string_view name((*context.document())["entries"][1]["name"].GetString());
+    CHECK(name == "Entry1");
+
+    CHECK_FALSE(context.Load(dir / "broken.json"));
+    CHECK_FALSE(context.document());
+    CHECK_FALSE(context.Load(dir / "missing.json"));
+    REQUIRE(context.Load(dir / "small.json"));
+    CHECK(context.document());
+}
+
+TEST_CASE("JSONLoadContext::Load allocates no more than parsing the same text", "[JSONLoadContext]") {
+    const auto dir = FreshDir("json_load_context_allocations");
+    const auto path = dir / std::string(200, 'p').append(".json");  // a path too long for the small string buffer
+    const auto json = Entries(50);
+    std::ofstream(path) << json;
+
+    Presets::JSONLoadContext context;
+    REQUIRE(context.Load(path));  // warms the buffers up
+
+    // Whatever the parser itself allocates (nothing with rapidjson's pool allocators), Load adds nothing on top:
+    // no copy of the path, no file buffer
+    const auto parse = CountAllocations([&] { REQUIRE(context.Parse(json)); });
+    const auto load = CountAllocations([&] { REQUIRE(context.Load(path)); });
+    CHECK(load == parse);
+}
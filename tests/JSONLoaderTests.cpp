@@ -0,0 +1,126 @@
+#include "CLibUtilsQTR/PresetHelpers/JSONLoader.hpp"
+#include <rapidjson/document.h>
+#include "Catch.h"
+
+namespace {
+    template <typename T>
+    using JsonField = Presets::Field<T, rapidjson::Value>;
+
+    // What the DOM lookup gives for a dotted path: walks objects, then Getters::JSON::Get on the value
+    template <typename T>
+    bool DomGet(const rapidjson::Value& a_root, const std::string_view a_path, T& a_out) {
+        const rapidjson::Value* value = &a_root;
+        for (const auto part : std::views::split(a_path, '.')) {
+            if (!value->IsObject()) return false;
+            const std::string key(part.begin(), part.end());
+            const auto it = value->FindMember(key.c_str());
+            if (it == value->MemberEnd()) return false;
+            value = &it->value;
+        }
+        return Presets::Getters::JSON::Get(*value, a_out);
+    }
+
+    // Loads a_json both ways and checks they agree, including on which fields keep their default
+    template <typename T>
+    void CheckMatchesDom(const std::string& a_json, const std::string& a_path, const T& a_default) {
+        INFO(a_json << " @ " << a_path);
+        rapidjson::Document document;
+        document.Parse(a_json.c_str());
+        REQUIRE_FALSE(document.HasParseError());
+        T expected = a_default;
+        const bool dom_loaded = DomGet(document, a_path, expected);
+
+        JsonField<T> field(a_path, a_default);
+        Presets::JSONLoader loader;
+        REQUIRE(loader.Bind(field).LoadString(a_json));
+        CHECK(loader.loaded() == (dom_loaded ? 1u : 0u));
+        CHECK(field.get() == expected);
+    }
+}
+
+TEST_CASE("JSONLoader binds nested keys and skips unbound subtrees", "[JSONLoader]") {
+    JsonField<int> chance("spawn.chance", -1);
+    JsonField<std::string> name("name");
+    JsonField<float> scale("spawn.size.scale", 1.f);
+    JsonField<std::vector<std::string>> tags("tags");
+
+    Presets::JSONLoader loader;
+    loader.Bind(chance).Bind(name).Bind(scale).Bind(tags);
+    REQUIRE(loader.LoadString(R"({
+        "skipped": {"chance": 5, "spawn": {"chance": 6}, "list": [{"name": "inner"}, [1, 2]]},
+        "name": "Bandit",
+        "spawn": {"other": [1, {"chance": 7}], "chance": 40, "size": {"scale": 1.5}},
+        "tags": ["a", "b"],
+        "after": {"name": "ignored"}
+    })"));
+
+    CHECK(loader.loaded() == 4);
+    CHECK(chance.get() == 40);
+    CHECK(name.get() == "Bandit");
+    CHECK(scale.get() == 1.5f);
+    CHECK(tags.get() == std::vector<std::string>{"a", "b"});
+
+    // A custom path, and the first of duplicate keys
+    JsonField<int> level("unused", 0);
+    Presets::JSONLoader custom;
+    REQUIRE(custom.Bind("stats.level", level).LoadString(R"({"stats": {"level": 3, "level": 9}})"));
+    CHECK(level.get() == 3);
+
+    // Reused loader: counts restart and missing keys leave the fields alone
+    REQUIRE(loader.LoadString(R"({"spawn": {"chance": 10}})"));
+    CHECK(loader.loaded() == 1);
+    CHECK(chance.get() == 10);
+    CHECK(name.get() == "Bandit");
+    CHECK_FALSE(loader.LoadString(R"({"spawn": )"));
+}
+
+TEST_CASE("JSONLoader keeps the field when vector and scalar do not match", "[JSONLoader]") {
+    JsonField<std::vector<int>> list("list", {7});
+    JsonField<int> scalar("scalar", 7);
+    Presets::JSONLoader loader;
+    loader.Bind(list).Bind(scalar);
+
+    REQUIRE(loader.LoadString(R"({"list": 1, "scalar": [1, 2]})"));
+    CHECK(loader.loaded() == 0);
+    CHECK(list.get() == std::vector{7});
+    CHECK(scalar.get() == 7);
+
+    // One bad element, or a nested array/object, rejects the whole vector
+    for (const auto json : {R"({"list": [1, "x", 3]})", R"({"list": [1, [2], 3]})", R"({"list": [1, {"a": 2}]})"}) {
+        INFO(json);
+        REQUIRE(loader.LoadString(json));
+        CHECK(loader.loaded() == 0);
+        CHECK(list.get() == std::vector{7});
+    }
+
+    REQUIRE(loader.LoadString(R"({"list": [], "scalar": {"value": 1}})"));
+    CHECK(loader.loaded() == 1);
+    CHECK(list.get().empty());
+    CHECK(scalar.get() == 7);
+}
+
+TEST_CASE("JSONLoader agrees with the DOM getters", "[JSONLoader]") {
+    const std::vector<std::string> documents{
+        R"({"a": 1, "b": {"c": -2, "d": [1, 2, 3]}, "e": "text"})",
+        R"({"a": 1.5, "b": {"c": "3", "d": [1, 2.5]}, "e": 4})",
+        R"({"a": 4294967295, "b": {"c": [1], "d": []}, "e": ["x", "y"]})",
+        R"({"a": true, "b": 3, "e": null})",
+        R"({"a": -9000000000, "b": {"c": {"x": 1}, "d": [1, null]}, "a": 2})",
+        R"([1, 2, {"a": 3}])",
+    };
+    for (const auto& json : documents) {
+        for (const std::string path : {"a", "b.c", "e"}) {
+            CheckMatchesDom<int>(json, path, 11);
+            CheckMatchesDom<std::uint32_t>(json, path, 11u);
+            CheckMatchesDom<std::int64_t>(json, path, 11);
+            CheckMatchesDom<double>(json, path, 0.25);
+            CheckMatchesDom<bool>(json, path, false);
+            CheckMatchesDom<std::string>(json, path, "default");
+        }
+        for (const std::string path : {"b.d", "e", "a"}) {
+            CheckMatchesDom<std::vector<int>>(json, path, {9});
+            CheckMatchesDom<std::vector<double>>(json, path, {9.0});
+            CheckMatchesDom<std::vector<std::string>>(json, path, {"default"});
+        }
+    }
+}
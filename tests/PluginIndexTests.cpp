@@ -0,0 +1,69 @@
+#include "CLibUtilsQTR/PluginIndex.hpp"
+#include "Catch.h"
+
+TEST_CASE("PluginIndex finds plugins by name regardless of case", "[PluginIndex]") {
+    const std::vector<FormReader::PluginRecord> plugins{
+        {"Skyrim.esm", 0x00, false},
+        {"Update.esm", 0x01, false},
+        {"ccBGSSSE001-Fish.esm", 0x000, true},
+        {"SKYRIM.ESM", 0x05, false},  // duplicates keep the first occurrence
+        {"", 0x06, false},
+    };
+    FormReader::PluginIndex index;
+    CHECK_FALSE(index.IsBuilt());
+    CHECK_FALSE(index.Find("Skyrim.esm"));
+    index.Build(plugins);
+    REQUIRE(index.IsBuilt());
+
+    for (const auto name : {"Skyrim.esm", "skyrim.esm", "SKYRIM.ESM"}) {
+        const auto entry = index.Find(name);
+        REQUIRE(entry);
+        CHECK(entry->index == 0x00);
+        CHECK_FALSE(entry->light);
+    }
+    REQUIRE(index.Find("ccbgssse001-fish.ESM"));
+    CHECK(index.Find("ccbgssse001-fish.ESM")->light);
+    CHECK_FALSE(index.Find("Dawnguard.esm"));
+    CHECK_FALSE(index.Find("Skyrim.es"));
+    CHECK_FALSE(index.Find(""));
+    CHECK(index.Find(StringHelpers::fnv1a_ci("update.esm"), "update.esm"));
+}
+
+TEST_CASE("PluginIndex composes full and light FormIDs like the data handler", "[PluginIndex]") {
+    using FormReader::PluginIndex;
+    CHECK(PluginIndex::Compose({0x02, false}, 0x00012EB7) == 0x02012EB7);
+    CHECK(PluginIndex::Compose({0x02, false}, 0xFF012EB7) == 0x02012EB7);  // the load order byte is replaced
+    CHECK(PluginIndex::Compose({0x123, true}, 0x00000801) == 0xFE123801);
+    CHECK(PluginIndex::Compose({0x123, true}, 0x00012801) == 0xFE123801);  // light plugins keep 12 bits
+
+    TestGame::Reset();
+    TestGame::SetLoadOrder({"Skyrim.esm", "Update.esm", "Dawnguard.esm"}, {"Light1.esp", "Light2.esl"});
+    PluginIndex index;
+    index.BuildFromDataHandler();
+    const auto dataHandler = RE::TESDataHandler::GetSingleton();
+    for (const auto plugin : {"Skyrim.esm", "Update.esm", "Dawnguard.esm", "Light1.esp", "Light2.esl"}) {
+        for (const std::uint32_t local : {0x000800u, 0x012EB7u, 0xFFFFFFu}) {
+            INFO(plugin << " " << local);
+            CHECK(index.Resolve(local, plugin) == dataHandler->LookupFormID(local, plugin));
+        }
+    }
+    CHECK(index.Resolve(0x800, "Missing.esp") == 0);
+    TestGame::Reset();
+}
+
+TEST_CASE("PluginIndex rebuilds replace the load order", "[PluginIndex]") {
+    FormReader::PluginIndex index;
+    const std::vector<FormReader::PluginRecord> first{{"Skyrim.esm", 0, false}, {"Mod.esp", 1, false}};
+    const std::vector<FormReader::PluginRecord> moved{{"Skyrim.esm", 0, false}, {"Other.esp", 1, false},
+                                                      {"Mod.esp", 2, false}};
+    index.Build(first);
+    const auto hash = index.LoadOrderHash();
+    CHECK(index.Resolve(0x800, "Mod.esp") == 0x01000800);
+
+    for (int i = 0; i < 4; ++i) index.Build(i % 2 ? first : moved);
+    CHECK(index.LoadOrderHash() == hash);
+    index.Build(moved);
+    CHECK(index.LoadOrderHash() != hash);
+    CHECK(index.Resolve(0x800, "Mod.esp") == 0x02000800);
+    CHECK(index.Resolve(0x800, "other.ESP") == 0x01000800);
+}
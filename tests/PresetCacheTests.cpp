@@ -0,0 +1,177 @@
+#include "CLibUtilsQTR/PresetHelpers/GettersYAML.hpp"
+#include "CLibUtilsQTR/PresetHelpers/PresetCache.hpp"
+#include "Catch.h"
+
+namespace {
+    struct Limits {
+        float min = 0.f;
+        float max = 1.f;
+
+        static constexpr auto schema = Presets::Schema{
+            Presets::Key("min", &Limits::min),
+            Presets::Key("max", &Limits::max),
+        };
+    };
+
+    struct Spawn {
+        Presets::Field<int, rapidjson::Value> chance{"unused", 5};
+        Presets::Field<std::vector<std::string>, rapidjson::Value> items{"items"};
+        Presets::Field<bool, ::YAML::Node> enabled{"enabled", false};
+        std::string name;
+        std::vector<RE::FormID> forms;
+        std::vector<Limits> limits;
+
+        static constexpr auto schema = Presets::Schema{
+            Presets::Key("chance", &Spawn::chance),
+            Presets::Key("items", &Spawn::items),
+            Presets::Key("enabled", &Spawn::enabled),
+            Presets::Key("name", &Spawn::name),
+            Presets::Key("forms", &Spawn::forms),
+            Presets::Key("limits", &Spawn::limits),
+        };
+    };
+
+    void CheckSame(const Spawn& a_lhs, const Spawn& a_rhs) {
+        CHECK(a_lhs.chance.get() == a_rhs.chance.get());
+        CHECK(a_lhs.items.get() == a_rhs.items.get());
+        CHECK(a_lhs.enabled.get() == a_rhs.enabled.get());
+        CHECK(a_lhs.name == a_rhs.name);
+        CHECK(a_lhs.forms == a_rhs.forms);
+        REQUIRE(a_lhs.limits.size() == a_rhs.limits.size());
+        for (std::size_t i = 0; i < a_lhs.limits.size(); ++i) {
+            CHECK(a_lhs.limits[i].min == a_rhs.limits[i].min);
+            CHECK(a_lhs.limits[i].max == a_rhs.limits[i].max);
+        }
+    }
+
+    std::filesystem::path FreshDir(const std::string_view a_name) {
+        const auto dir = std::filesystem::temp_directory_path() / "clibutilsqtr_tests" / a_name;
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+}
+
+TEST_CASE("Schema structs with Field members load and round-trip through the cache", "[PresetCache]") {
+    rapidjson::Document document;
+    document.Parse(R"({"chance": 40, "items": ["a", "b"], "enabled": true, "name": "Bandit", "forms": [1, 2],
+                       "limits": [{"min": 0.5}, {"max": 2.5}], "unused": 7})");
+    REQUIRE_FALSE(document.HasParseError());
+    Spawn from_json;
+    REQUIRE(Presets::Getters::JSON::GetStruct(document, from_json));
+    CHECK(from_json.chance.get() == 40);  // the schema key wins over the Field's own key
+    CHECK(from_json.items.get() == std::vector<std::string>{"a", "b"});
+    CHECK(from_json.enabled.get());
+
+    Spawn from_yaml;
+    REQUIRE(Presets::Getters::YAML::GetStruct(
+        YAML::Load("{chance: 40, items: [a, b], enabled: true, name: Bandit, forms: [1, 2], "
+                   "limits: [{min: 0.5}, {max: 2.5}]}"),
+        from_yaml));
+    CheckSame(from_json, from_yaml);
+
+    // Wrong shapes leave Field members alone, like plain ones
+    Spawn untouched;
+    document.Parse(R"({"chance": "x", "items": "a", "enabled": 1})");
+    REQUIRE(Presets::Getters::JSON::GetStruct(document, untouched));
+    CHECK(untouched.chance.get() == 5);
+    CHECK(untouched.items.get().empty());
+    CHECK_FALSE(untouched.enabled.get());
+
+    const auto path = FreshDir("preset_cache_schema") / "spawn.bin";
+    REQUIRE(Presets::Cache::Write(path, 1, 2, from_json));
+    Spawn read;
+    REQUIRE(Presets::Cache::Read(path, 1, 2, read));
+    CheckSame(read, from_json);
+}
+
+namespace {
+    struct Flags {
+        bool on = false;
+        std::vector<bool> list;
+        std::vector<RE::FormID> forms;
+
+        static constexpr auto schema = Presets::Schema{
+            Presets::Key("on", &Flags::on),
+            Presets::Key("list", &Flags::list),
+            Presets::Key("forms", &Flags::forms),
+        };
+    };
+}
+
+TEST_CASE("PresetCache stores bools as bytes", "[PresetCache]") {
+    const auto path = FreshDir("preset_cache_bools") / "flags.bin";
+    REQUIRE(Presets::Cache::Write(path, 1, 2, Flags{true, {true, false, true}, {7}}));
+    Flags read;
+    REQUIRE(Presets::Cache::Read(path, 1, 2, read));
+    CHECK(read.on);
+    CHECK(read.list == std::vector{true, false, true});
+
+    // A byte other than 0 or 1 still reads as true instead of landing in the bool as is
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    REQUIRE(bytes.size() > sizeof(Presets::Cache::Header));
+    bytes[sizeof(Presets::Cache::Header)] = 2;
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    Flags corrupt;
+    REQUIRE(Presets::Cache::Read(path, 1, 2, corrupt));
+    CHECK(corrupt.on == true);
+
+    // Truncated payloads are refused
+    bytes.pop_back();
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    CHECK_FALSE(Presets::Cache::Read(path, 1, 2, corrupt));
+}
+
+TEST_CASE("PresetCache refuses snapshots of changed sources, groups or load order", "[PresetCache]") {
+    const auto dir = FreshDir("preset_cache_stale");
+    const auto cache_path = dir / "flags.bin";
+    const std::vector<std::filesystem::path> sources{dir / "a.txt", dir / "b.txt"};
+    std::ofstream(sources[0]) << "CacheGroup";
+    std::ofstream(sources[1]) << "on";
+    PresetHelpers::SetFormGroup("CacheGroup", {1, 2});
+
+    // Stands in for parsing the sources: copies the group the first file names
+    int compiled = 0;
+    const auto compile = [&](Flags& a_out) {
+        ++compiled;
+        a_out = {};
+        std::ifstream in(sources[0]);
+        const std::string group((std::istreambuf_iterator<char>(in)), {});
+        if (const auto ids = PresetHelpers::FindFormGroup(group)) a_out.forms.assign(ids->begin(), ids->end());
+        a_out.on = true;
+    };
+    const auto load = [&](const std::uint64_t a_load_order = 1) {
+        Flags out;
+        const bool cached = Presets::Cache::LoadCached(cache_path, sources, out, compile, a_load_order);
+        return std::pair{cached, out.forms};
+    };
+
+    CHECK(load() == std::pair{false, std::vector<RE::FormID>{1, 2}});
+    CHECK(load() == std::pair{true, std::vector<RE::FormID>{1, 2}});
+    CHECK(compiled == 1);
+
+    // An edited source file
+    std::ofstream(sources[1]) << "off";
+    CHECK_FALSE(load().first);
+    CHECK(load().first);
+
+    // A different group under the same name: the sources are unchanged, but they resolve differently now
+    PresetHelpers::SetFormGroup("CacheGroup", {3});
+    CHECK(load() == std::pair{false, std::vector<RE::FormID>{3}});
+    CHECK(load() == std::pair{true, std::vector<RE::FormID>{3}});
+
+    // Another load order
+    CHECK_FALSE(load(2).first);
+    CHECK(load(2).first);
+    CHECK(compiled == 4);
+
+    // A missing source file is never cached
+    std::filesystem::remove(sources[1]);
+    CHECK_FALSE(load(2).first);
+    CHECK_FALSE(load(2).first);
+    CHECK(compiled == 6);
+}
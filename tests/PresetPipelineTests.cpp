@@ -0,0 +1,55 @@
+#include "CLibUtilsQTR/PresetHelpers/PresetHelpersYAML.hpp"
+#include "CLibUtilsQTR/PresetHelpers/PresetPipeline.hpp"
+#include "Catch.h"
+
+TEST_CASE("Pipeline resolves groups and expressions like CollectFrom", "[PresetPipeline]") {
+    TestGame::Reset();
+    TestGame::AddForm(0x00012EB7, "IronSword");
+    TestGame::AddForm(0x00013989, "IronDagger");
+    TestGame::AddForm(0x00013790, "SteelDagger");
+    PresetHelpers::SetFormGroup("PipelineDaggers", {0x00013989, 0x00013790});
+    PresetHelpers::SetFormGroup("PipelineSteel", {0x00013790});
+
+    const auto dir = std::filesystem::temp_directory_path() / "clibutilsqtr_tests" / "preset_pipeline";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "a.yaml") << "forms: [PipelineDaggers, IronSword, Unknown]\n";
+    std::ofstream(dir / "b.yaml") << "forms: [\"PipelineDaggers - PipelineSteel\", \"(PipelineSteel + IronSword)\"]\n";
+    std::ofstream(dir / "c.yaml") << "forms: PipelineSteel\n";
+
+    const auto files = Presets::ListPresetFiles(dir, {".yaml"});
+    REQUIRE(files.size() == 3);
+
+    std::vector<std::vector<RE::FormID>> expected;
+    for (const auto& file : files) {
+        expected.push_back(PresetHelpers::YAML_Helpers::CollectFrom<RE::FormID, std::string>(
+            YAML::LoadFile(file.string()), "forms"));
+    }
+
+    using Requested = std::vector<Presets::FormRequest>;
+    std::vector<std::vector<RE::FormID>> loaded;
+    const auto stats = Presets::LoadPresets<Requested>(
+        files,
+        [](const std::filesystem::path&, const std::string_view a_contents, Requested& a_result,
+           Presets::FormRequests& a_requests) {
+            const auto forms = YAML::Load(std::string(a_contents))["forms"];
+            if (forms.IsScalar()) {
+                a_result.push_back(a_requests.Request(forms.Scalar()));
+            } else {
+                for (const auto& form : forms) a_result.push_back(a_requests.Request(form.Scalar()));
+            }
+            return true;
+        },
+        [&](const std::filesystem::path&, Requested& a_result, const Presets::FormRequests& a_requests) {
+            auto& ids = loaded.emplace_back();
+            for (const auto request : a_result) {
+                const auto resolved = a_requests.GetAll(request);
+                ids.insert(ids.end(), resolved.begin(), resolved.end());
+            }
+        },
+        4);
+
+    CHECK(stats.failed == 0);
+    CHECK(loaded == expected);
+    CHECK(loaded[1] == std::vector<RE::FormID>{0x00013989, 0x00012EB7, 0x00013790});
+}
@@ -0,0 +1,109 @@
+#include "CLibUtilsQTR/PresetSettings.hpp"
+#include "Catch.h"
+
+namespace {
+    constexpr clib_utilsQTR::PresetPool<3> kPool{{"Low", "Medium", "High"}};
+
+    // Large enough that a writer can lap a reader in the middle of its copy
+    struct Wide {
+        std::array<std::uint64_t, 256> values;
+    };
+
+    // Runs a copy of a_read on each of a_readers threads until a_write returns; returns how many reads were rejected
+    template <typename Write, typename Read>
+    std::size_t Race(const std::size_t a_readers, Write&& a_write, Read&& a_read) {
+        std::atomic<bool> done{false};
+        std::atomic<std::size_t> failures{0};
+        std::vector<std::jthread> readers;
+        for (std::size_t i = 0; i < a_readers; ++i) {
+            readers.emplace_back([&, read = a_read]() mutable {
+                while (!done.load(std::memory_order_relaxed)) {
+                    if (!read()) failures.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        a_write();
+        done = true;
+        readers.clear();
+        return failures.load();
+    }
+}
+
+TEST_CASE("PresetBlock readers never see a torn block", "[PresetBlock]") {
+    constexpr std::uint64_t kPublishes = 200'000;
+    clib_utilsQTR::PresetBlock<Wide> block;
+
+    const auto failures = Race(
+        4,
+        [&] {
+            for (std::uint64_t i = 1; i <= kPublishes; ++i) {
+                block.Update([i](Wide& a_block) { a_block.values.fill(i); });
+            }
+        },
+        [&, last = std::uint64_t{0}]() mutable {
+            const auto values = block.Read().values;
+            const bool ok = std::ranges::all_of(values, [&](const auto a_value) { return a_value == values[0]; }) &&
+                            values[0] >= last;
+            last = values[0];
+            return ok;
+        });
+
+    CHECK(failures == 0);
+    CHECK(block.version() == kPublishes);
+    CHECK(block.Read().values.back() == kPublishes);
+    CHECK(block.Get(&Wide::values)[0] == kPublishes);
+}
+
+TEST_CASE("PresetPool publishes levels and values through PresetBlocks", "[PresetSettings]") {
+    clib_utilsQTR::PresetSetting<float, 3, kPool> range{{100.0f, 200.0f, 300.0f}};
+    clib_utilsQTR::PresetSetting<int, 3, kPool> count{{1, 2, 3}};
+
+    // Every value read while apply() runs belongs to the level published with it
+    const auto consistent = [](const auto& a_setting) {
+        const auto state = a_setting.read();
+        return state.level < 3 && state.value == a_setting.for_level(state.level);
+    };
+    const auto failures = Race(
+        4,
+        [&] {
+            for (std::size_t i = 0; i < 20'000; ++i) kPool.apply(i % 3);
+        },
+        [&] {
+            const float value = range;
+            return kPool.current() < 3 && consistent(range) && consistent(count) &&
+                   (value == 100.0f || value == 200.0f || value == 300.0f);
+        });
+
+    CHECK(failures == 0);
+    CHECK(kPool.current() == 1);  // 19'999 % 3
+    CHECK(range.get() == 200.0f);
+    CHECK(count.level() == 1);
+    CHECK(count.name() == "Medium");
+
+    count = 7;
+    CHECK(count.name() == "Custom");
+    CHECK(count.read().value == 7);
+    kPool.apply(2);
+    CHECK(kPool.current() == 2);
+    CHECK(count.name() == "High");
+}
+
+TEST_CASE("PresetSetting levels follow the value", "[PresetSettings]") {
+    clib_utilsQTR::PresetSetting<int, 3, kPool> setting{{1, 2, 2}};
+    setting.set_level(2);
+    CHECK(setting.level() == 2);  // not the first level holding the same value
+    CHECK(static_cast<int>(setting) == 2);
+    CHECK(setting.level() == 2);
+
+    setting = 1;
+    CHECK(setting.level() == 0);
+    setting = 2;
+    CHECK(setting.level() == 1);
+    setting = 9;
+    CHECK(setting.level() == clib_utilsQTR::PresetPool<3>::kCustom);
+    CHECK(setting.name() == "Custom");
+
+    const auto copy = setting;
+    CHECK(copy.get() == 9);
+    CHECK(copy.level() == clib_utilsQTR::PresetPool<3>::kCustom);
+}
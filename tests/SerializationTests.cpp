@@ -0,0 +1,178 @@
+#include "CLibUtilsQTR/Serialization.hpp"
+#include "Catch.h"
+
+TEST_CASE("Strings round-trip in one record write", "[Serialization]") {
+    SKSE::SerializationInterface intfc;
+    REQUIRE(Serialization::write_string(&intfc, "Iron Sword"));
+    REQUIRE(Serialization::write_string(&intfc, ""));
+    CHECK(intfc.calls == 2);
+
+    std::string first;
+    std::string second = "x";
+    REQUIRE(Serialization::read_string(&intfc, first));
+    REQUIRE(Serialization::read_string(&intfc, second));
+    CHECK(first == "Iron Sword");
+    CHECK(second.empty());
+}
+
+TEST_CASE("Legacy strings still load", "[Serialization]") {
+    SKSE::SerializationInterface intfc;
+    const auto encoded = Serialization::encodeString("Old Save");
+    intfc.WriteRecordData(encoded.size());
+    intfc.WriteRecordData(encoded.data(), static_cast<std::uint32_t>(encoded.size() * sizeof(encoded[0])));
+
+    std::string str;
+    REQUIRE(Serialization::read_string(&intfc, str));
+    CHECK(str == "Old Save");
+}
+
+TEST_CASE("Damaged string lengths are rejected before allocating", "[Serialization]") {
+    for (const std::size_t header : {Serialization::kStringV2Tag | (std::size_t{1} << 40),
+                                     Serialization::kStringV2Tag | (Serialization::kMaxStringLength + 1),
+                                     std::size_t{1} << 40}) {
+        SKSE::SerializationInterface intfc;
+        intfc.WriteRecordData(header);
+        std::string str = "unchanged";
+        CHECK_FALSE(Serialization::read_string(&intfc, str));
+        CHECK(str == "unchanged");
+    }
+
+    SKSE::SerializationInterface intfc;
+    CHECK_FALSE(Serialization::write_string(&intfc, std::string(Serialization::kMaxStringLength + 1, 'a')));
+    CHECK(intfc.data.empty());
+}
+
+namespace {
+    // Keys whose std::hash is a small constant set, so they pile up in one shard and probe past each other
+    struct CollidingKey {
+        std::uint32_t id = 0;
+        bool operator==(const CollidingKey&) const = default;
+    };
+}
+
+template <>
+struct std::hash<CollidingKey> {
+    std::size_t operator()(const CollidingKey& a_key) const noexcept { return a_key.id % 3; }
+};
+
+namespace {
+    template <typename T, typename U, std::size_t Shards = 16>
+    struct Store final : Serialization::ShardedBaseData<T, U, Shards> {
+        const char* GetType() override { return "Store"; }
+    };
+
+    // Everything ForEach visits, checked against a_expected; each key must come up exactly once
+    template <typename Sharded, typename Map>
+    void CheckSame(const Sharded& a_store, const Map& a_expected) {
+        Map visited;
+        a_store.ForEach([&](const auto& a_key, const auto& a_value) { CHECK(visited.emplace(a_key, a_value).second); });
+        CHECK(visited == a_expected);
+        CHECK(a_store.size() == a_expected.size());
+        for (const auto& [key, value] : a_expected) CHECK(a_store.GetData(key, {}) == value);
+    }
+}
+
+TEST_CASE("ShardedBaseData gets, sets and overwrites", "[ShardedBaseData]") {
+    Store<RE::FormID, float> store;
+    CHECK(store.size() == 0);
+    CHECK(store.GetData(0x14, -1.0f) == -1.0f);
+
+    store.SetData(0x14, 1.0f);
+    store.SetData(0x00012EB7, 2.0f);
+    CHECK(store.GetData(0x14, -1.0f) == 1.0f);
+    CHECK(store.GetData(0x00012EB7, -1.0f) == 2.0f);
+    CHECK(store.GetData(0x15, -1.0f) == -1.0f);
+    CHECK(store.size() == 2);
+
+    // Overwriting keeps one entry per key
+    store.SetData(0x14, 3.0f);
+    CHECK(store.GetData(0x14, -1.0f) == 3.0f);
+    CHECK(store.size() == 2);
+
+    store.Clear();
+    CHECK(store.size() == 0);
+    CHECK(store.GetData(0x14, -1.0f) == -1.0f);
+    store.ForEach([](const auto&, const auto&) { FAIL("visited a cleared entry"); });
+
+    // Usable again after Clear
+    store.SetData(0x14, 4.0f);
+    CHECK(store.GetData(0x14, -1.0f) == 4.0f);
+    CHECK(store.size() == 1);
+}
+
+TEST_CASE("ShardedBaseData keeps every entry across growth", "[ShardedBaseData]") {
+    Store<RE::FormID, std::uint32_t> store;
+    std::unordered_map<RE::FormID, std::uint32_t> expected;
+
+    // Enough keys for every shard to grow several times, with overwrites in between
+    for (std::uint32_t i = 0; i < 20'000; ++i) {
+        const RE::FormID key = 0x00010000 + i * 7;
+        store.SetData(key, i);
+        expected[key] = i;
+        if (i % 5 == 0) {
+            const RE::FormID earlier = 0x00010000 + (i / 2) * 7;
+            store.SetData(earlier, i + 1);
+            expected[earlier] = i + 1;
+        }
+    }
+    CheckSame(store, expected);
+    CHECK(store.GetData(0x00010000 + 1, 99u) == 99u);
+}
+
+TEST_CASE("ShardedBaseData probes past colliding keys", "[ShardedBaseData]") {
+    // Every key hashes to one of three slots: lookups have to walk the probe chain, wrap around the table end and stop
+    // at the first empty slot, and growing has to rehash the whole chain
+    Store<CollidingKey, int, 1> single;
+    Store<CollidingKey, int> sharded;
+    std::unordered_map<std::uint32_t, int> expected;
+    for (std::uint32_t i = 0; i < 500; ++i) {
+        single.SetData({i}, static_cast<int>(i));
+        sharded.SetData({i}, static_cast<int>(i));
+        expected[i] = static_cast<int>(i);
+        if (i % 7 == 0) {
+            single.SetData({i / 2}, -static_cast<int>(i));
+            sharded.SetData({i / 2}, -static_cast<int>(i));
+            expected[i / 2] = -static_cast<int>(i);
+        }
+    }
+    CHECK(single.size() == expected.size());
+    CHECK(sharded.size() == expected.size());
+    for (const auto& [id, value] : expected) {
+        CHECK(single.GetData({id}, 12345) == value);
+        CHECK(sharded.GetData({id}, 12345) == value);
+    }
+    // Misses end at an empty slot even though they share a start slot with hundreds of keys
+    CHECK(single.GetData({1000}, 12345) == 12345);
+    CHECK(sharded.GetData({1001}, 12345) == 12345);
+
+    std::size_t visited = 0;
+    single.ForEach([&](const CollidingKey& a_key, const int a_value) {
+        ++visited;
+        CHECK(expected.at(a_key.id) == a_value);
+    });
+    CHECK(visited == expected.size());
+}
+
+TEST_CASE("ShardedBaseData takes concurrent writers", "[ShardedBaseData]") {
+    constexpr std::uint32_t kThreads = 4;
+    constexpr std::uint32_t kKeysPerThread = 5'000;
+    Store<RE::FormID, std::uint32_t> store;
+    std::atomic<std::size_t> lost{0};  // Catch assertions are not thread safe
+    {
+        std::vector<std::jthread> threads;
+        for (std::uint32_t t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&store, &lost, t] {
+                for (std::uint32_t i = 0; i < kKeysPerThread; ++i) {
+                    const auto key = i * kThreads + t;
+                    store.SetData(key, key + 1);
+                    if (store.GetData(key, 0) != key + 1) lost.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+    }
+    CHECK(lost == 0);
+
+    std::unordered_map<RE::FormID, std::uint32_t> expected;
+    for (std::uint32_t key = 0; key < kThreads * kKeysPerThread; ++key) expected[key] = key + 1;
+    CheckSame(store, expected);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+// Minimal benchmark registry: every BENCH_CASE runs from main(), or only those whose name contains argv[1]
+namespace Bench {
+    struct Case {
+        std::string_view name;
+        void (*run)();
+    };
+
+    inline std::vector<Case>& Registry() {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    struct Registrar {
+        Registrar(const std::string_view a_name, void (*a_run)()) { Registry().push_back({a_name, a_run}); }
+    };
+
+    // Median wall time of a_runs calls, in milliseconds
+    template <typename Func>
+    double MedianMs(Func&& a_func, const int a_runs = 5) {
+        std::vector<double> times;
+        for (int i = 0; i < a_runs; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            a_func();
+            times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::ranges::sort(times);
+        return times[times.size() / 2];
+    }
+
+    inline void Report(const std::string_view a_case, const std::string_view a_variant, const double a_ms,
+                       const std::string_view a_note = {}) {
+        std::printf("%-28.*s %-40.*s %10.2f ms  %.*s\n", static_cast<int>(a_case.size()), a_case.data(),
+                    static_cast<int>(a_variant.size()), a_variant.data(), a_ms, static_cast<int>(a_note.size()),
+                    a_note.data());
+    }
+}
+
+#define BENCH_CASE(name) BENCH_CASE_AT(name, __LINE__)
+#define BENCH_CASE_AT(name, line) BENCH_CASE_DEFINE(name, line)
+#define BENCH_CASE_DEFINE(name, line)                                                 \
+    static void bench_case_##line();                                                  \
+    static const Bench::Registrar bench_registrar_##line{name, &bench_case_##line}; \
+    static void bench_case_##line()
@@ -0,0 +1,41 @@
+#include "CLibUtilsQTR/FormBatchConverter.hpp"
+#include "Bench.hpp"
+
+BENCH_CASE("FormBatchConverter") {
+    constexpr std::size_t kLines = 2'000'000;
+    std::string input;
+    input.reserve(kLines * 9);
+    char line[16];
+    for (std::size_t i = 0; i < kLines; ++i) {
+        std::snprintf(line, sizeof(line), "%08zX\n", (i % 7 ? 0x0A000000 : 0x01000000) + (i & 0xFFFFFF));
+        input += line;
+    }
+
+    const auto report = [](const std::string_view a_variant, const double a_ms) {
+        const auto rate = std::to_string(static_cast<std::size_t>(kLines / (a_ms / 1000.0))) + " lines/s";
+        Bench::Report("FormBatchConverter", a_variant, a_ms, rate);
+    };
+
+    report("processInput(string) loop", Bench::MedianMs([&] {
+        std::string out;
+        std::size_t begin = 0;
+        while (begin < input.size()) {
+            const auto end = input.find('\n', begin);
+            const auto result = FormReader::processInput(input.substr(begin, end - begin), std::string("My.esp"));
+            if (!result.error) out += result.output + '\n';
+            begin = end == std::string::npos ? input.size() : end + 1;
+        }
+    }, 3));
+
+    std::vector<std::size_t> thread_counts{1};
+    if (const auto all = clib_utilsQTR::DefaultThreadCount(); all > 1) thread_counts.push_back(all);
+    for (const auto threads : thread_counts) {
+        FormReader::BatchOptions options;
+        options.threads = threads;
+        report("ConvertBuffer, " + std::to_string(threads) + " thread(s)", Bench::MedianMs([&] {
+            std::size_t bytes = 0;
+            FormReader::ConvertBuffer(input, "My.esp", [&bytes](const std::string_view a_text) { bytes += a_text.size(); },
+                                      options);
+        }));
+    }
+}
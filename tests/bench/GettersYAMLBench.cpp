@@ -0,0 +1,47 @@
+#include "CLibUtilsQTR/PresetHelpers/GettersYAML.hpp"
+#include "Bench.hpp"
+
+namespace {
+    constexpr std::size_t kValues = 200'000;
+
+    // Sum of every value read with a_get, so the conversions cannot be dropped
+    template <typename T, typename Get>
+    double Run(const YAML::Node& a_values, Get&& a_get) {
+        return Bench::MedianMs([&] {
+            T sum{};
+            for (const auto& node : a_values) sum += a_get(node);
+            if (sum == T{42}) std::abort();
+        });
+    }
+
+    template <typename T>
+    void Compare(const std::string_view a_type, const YAML::Node& a_values, const std::string& a_note) {
+        Bench::Report("GettersYAML", std::string(a_type) + ": as<T>()", Run<T>(a_values, [](const YAML::Node& a_node) {
+            return a_node.as<T>();
+        }), a_note);
+        Bench::Report("GettersYAML", std::string(a_type) + ": GetScalar", Run<T>(a_values, [](const YAML::Node& a_node) {
+            T value{};
+            if (!Presets::Getters::YAML::GetScalar(a_node, value)) std::abort();
+            return value;
+        }), a_note);
+    }
+}
+
+BENCH_CASE("GettersYAML") {
+    std::string ints = "[";
+    std::string floats = "[";
+    for (std::size_t i = 0; i < kValues; ++i) {
+        ints += std::to_string(i * 37 % 100'000) + ",";
+        floats += std::to_string(static_cast<double>(i % 1000) / 8.0) + ",";
+    }
+    ints.back() = ']';
+    floats.back() = ']';
+    const auto int_nodes = YAML::Load(ints);
+    const auto float_nodes = YAML::Load(floats);
+
+    const auto note = std::to_string(kValues) + " scalars";
+    Compare<int>("int", int_nodes, note);
+    Compare<std::uint32_t>("uint32", int_nodes, note);
+    Compare<float>("float", float_nodes, note);
+    Compare<double>("double", float_nodes, note);
+}
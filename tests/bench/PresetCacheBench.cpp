@@ -0,0 +1,94 @@
+#include "CLibUtilsQTR/PresetHelpers/PresetCache.hpp"
+#include "CLibUtilsQTR/PresetHelpers/PresetHelpersYAML.hpp"
+#include "CLibUtilsQTR/PresetHelpers/PresetPipeline.hpp"
+#include "Bench.hpp"
+
+namespace {
+    struct Entry {
+        std::string name;
+        float weight = 0.0f;
+        std::vector<RE::FormID> forms;
+
+        static constexpr auto schema = Presets::Schema{
+            Presets::Key("name", &Entry::name),
+            Presets::Key("weight", &Entry::weight),
+            Presets::Key("forms", &Entry::forms),
+        };
+    };
+
+    struct Compiled {
+        std::vector<Entry> entries;
+
+        static constexpr auto schema = Presets::Schema{Presets::Key("entries", &Compiled::entries)};
+    };
+
+    struct Parsed {
+        std::vector<Entry> entries;
+        std::vector<std::vector<Presets::FormRequest>> requests;
+    };
+}
+
+BENCH_CASE("PresetCache") {
+    constexpr std::size_t kFiles = 100;
+    constexpr std::size_t kEntriesPerFile = 500;
+    constexpr std::size_t kForms = 2000;
+
+    TestGame::Reset();
+    for (std::size_t i = 0; i < kForms; ++i) {
+        TestGame::AddForm(static_cast<RE::FormID>(0x00010000 + i), "BenchForm" + std::to_string(i));
+    }
+
+    const auto dir = std::filesystem::temp_directory_path() / "clibutilsqtr_bench" / "preset_cache";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "presets");
+    for (std::size_t f = 0; f < kFiles; ++f) {
+        std::ofstream out(dir / "presets" / ("preset" + std::to_string(f) + ".yaml"));
+        for (std::size_t e = 0; e < kEntriesPerFile; ++e) {
+            const auto n = f * kEntriesPerFile + e;
+            out << "- name: Entry" << n << "\n  weight: " << (n % 100) / 10.0 << "\n  forms: [BenchForm"
+                << n % kForms << ", BenchForm" << (n * 7) % kForms << "]\n";
+        }
+    }
+    const auto sources = Presets::ListPresetFiles(dir / "presets", {".yaml"});
+    const auto cache_path = dir / "presets.bin";
+
+    // Text path: parse every file on worker threads, resolve the forms in bulk, merge in file order
+    const auto compile = [&sources](Compiled& a_out) {
+        a_out = {};
+        Presets::LoadPresets<Parsed>(
+            sources,
+            [](const std::filesystem::path&, const std::string_view a_contents, Parsed& a_result,
+               Presets::FormRequests& a_requests) {
+                for (const auto& node : YAML::Load(std::string(a_contents))) {
+                    auto& entry = a_result.entries.emplace_back();
+                    Presets::Getters::YAML::Get(node, "name", entry.name);
+                    Presets::Getters::YAML::Get(node, "weight", entry.weight);
+                    auto& requests = a_result.requests.emplace_back();
+                    for (const auto& form : node["forms"]) requests.push_back(a_requests.Request(form.Scalar()));
+                }
+                return true;
+            },
+            [&a_out](const std::filesystem::path&, Parsed& a_result, const Presets::FormRequests& a_requests) {
+                for (std::size_t i = 0; i < a_result.entries.size(); ++i) {
+                    auto& entry = a_out.entries.emplace_back(std::move(a_result.entries[i]));
+                    for (const auto request : a_result.requests[i]) {
+                        const auto ids = a_requests.GetAll(request);
+                        entry.forms.insert(entry.forms.end(), ids.begin(), ids.end());
+                    }
+                }
+            });
+    };
+
+    const auto note = std::to_string(kFiles) + " files, " + std::to_string(kFiles * kEntriesPerFile) + " entries";
+    Compiled compiled;
+    Bench::Report("PresetCache", "cold: parse + resolve + write", Bench::MedianMs([&] {
+        std::filesystem::remove(cache_path);
+        if (Presets::Cache::LoadCached(cache_path, sources, compiled, compile, 1)) std::abort();
+    }, 3), note);
+
+    const auto expected = compiled.entries.size();
+    Bench::Report("PresetCache", "warm: hash sources + read", Bench::MedianMs([&] {
+        if (!Presets::Cache::LoadCached(cache_path, sources, compiled, compile, 1)) std::abort();
+    }), note);
+    if (compiled.entries.size() != expected) std::abort();
+}
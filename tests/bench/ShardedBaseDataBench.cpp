@@ -0,0 +1,54 @@
+#include "CLibUtilsQTR/Serialization.hpp"
+#include "Bench.hpp"
+
+namespace {
+    struct MapStore final : Serialization::BaseData<RE::FormID, float> {
+        const char* GetType() override { return "MapStore"; }
+    };
+
+    struct ShardedStore final : Serialization::ShardedBaseData<RE::FormID, float> {
+        const char* GetType() override { return "ShardedStore"; }
+    };
+
+    constexpr std::uint32_t kKeys = 5000;
+    constexpr std::uint32_t kOpsPerThread = 400'000;
+
+    // Every thread walks the keys in its own order and writes once every 64 operations
+    template <typename Store>
+    double Run(Store& a_store, const std::size_t a_threads) {
+        return Bench::MedianMs([&] {
+            std::vector<std::jthread> threads;
+            for (std::size_t t = 0; t < a_threads; ++t) {
+                threads.emplace_back([&a_store, t] {
+                    auto key = static_cast<std::uint32_t>(t * 7919);
+                    float sum = 0.0f;
+                    for (std::uint32_t i = 0; i < kOpsPerThread; ++i) {
+                        key = (key + 2654435761u) % kKeys;
+                        if ((i & 63) == 0) {
+                            a_store.SetData(0x00010000 + key, static_cast<float>(i));
+                        } else {
+                            sum += a_store.GetData(0x00010000 + key, 0.0f);
+                        }
+                    }
+                    if (sum < 0.0f) std::abort();
+                });
+            }
+        }, 3);
+    }
+}
+
+BENCH_CASE("ShardedBaseData") {
+    MapStore map;
+    ShardedStore sharded;
+    for (std::uint32_t key = 0; key < kKeys; ++key) {
+        map.SetData(0x00010000 + key, 1.0f);
+        sharded.SetData(0x00010000 + key, 1.0f);
+    }
+
+    const auto note = std::to_string(kKeys) + " keys, " + std::to_string(kOpsPerThread) + " ops/thread, 1 write in 64";
+    for (const std::size_t threads : {1, 4, 8}) {
+        const auto suffix = ", " + std::to_string(threads) + " thread(s)";
+        Bench::Report("ShardedBaseData", "map + recursive_mutex" + suffix, Run(map, threads), note);
+        Bench::Report("ShardedBaseData", "sharded" + suffix, Run(sharded, threads), note);
+    }
+}
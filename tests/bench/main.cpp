@@ -0,0 +1,9 @@
+#include "Bench.hpp"
+
+int main(const int argc, char** argv) {
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+    for (const auto& [name, run] : Bench::Registry()) {
+        if (name.find(filter) != std::string_view::npos) run();
+    }
+    return 0;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// Catch2 v3 split its single header, v2 ships catch.hpp; the tests only use the basic macros of either
+#if __has_include(<catch2/catch_test_macros.hpp>)
+    #include <catch2/catch_test_macros.hpp>
+#else
+    #include <catch2/catch.hpp>
+#endif
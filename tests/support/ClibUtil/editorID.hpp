@@ -0,0 +1,6 @@
+#pragma once
+
+// Stand-in for clib-util's EditorID accessor, backed by TestGame's form table
+namespace clib_util::editorID {
+    inline std::string get_editorID(const RE::TESForm* a_form) { return a_form ? a_form->editorID : std::string{}; }
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+// Host-side stand-ins for the parts of CommonLibSSE / SKSE the headers under test touch, so the tests build and
+// run without the game. Plugins get all of this from their own PCH; only what the tests need is modelled here.
+// TestGame:: controls the fake form table and load order.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace logger {
+    template <class... Args>
+    void trace(std::string_view, Args&&...) {}
+    template <class... Args>
+    void info(std::string_view, Args&&...) {}
+    template <class... Args>
+    void warn(std::string_view, Args&&...) {}
+    template <class... Args>
+    void error(std::string_view, Args&&...) {}
+}
+
+namespace RE {
+    using FormID = std::uint32_t;
+
+    template <class T>
+    struct BSTArray : std::vector<T> {};
+
+    template <class K, class V>
+    struct BSTHashMap : std::unordered_map<K, V> {};
+
+    struct BSReadWriteLock {};
+
+    struct BSReadLockGuard {
+        explicit BSReadLockGuard(BSReadWriteLock&) {}
+    };
+
+    struct TESForm;
+}
+
+namespace TestGame {
+    struct Forms {
+        std::deque<RE::TESForm> storage;
+        RE::BSTHashMap<RE::FormID, RE::TESForm*> by_id;
+        std::unordered_map<std::string, RE::TESForm*> by_editor_id;
+        RE::BSReadWriteLock lock;
+    };
+
+    inline Forms& forms() {
+        static Forms instance;
+        return instance;
+    }
+}
+
+namespace RE {
+    struct TESForm {
+        FormID formID = 0;
+        std::string editorID;  // not part of the real class, read by the clib_util::editorID stand-in
+
+        [[nodiscard]] FormID GetFormID() const { return formID; }
+
+        static TESForm* LookupByID(const FormID a_formID) {
+            const auto& map = TestGame::forms().by_id;
+            const auto it = map.find(a_formID);
+            return it != map.end() ? it->second : nullptr;
+        }
+
+        template <class T>
+        static T* LookupByID(const FormID a_formID) {
+            return LookupByID(a_formID);
+        }
+
+        // Like the game, the key goes through BSFixedString, which reads a_editorID.data() up to its terminator
+        static TESForm* LookupByEditorID(const std::string_view& a_editorID) {
+            const auto& map = TestGame::forms().by_editor_id;
+            const auto it = map.find(std::string(a_editorID.data()));
+            return it != map.end() ? it->second : nullptr;
+        }
+
+        template <class T>
+        static T* LookupByEditorID(const std::string_view& a_editorID) {
+            return LookupByEditorID(a_editorID);
+        }
+
+        static std::pair<BSTHashMap<FormID, TESForm*>*, std::reference_wrapper<BSReadWriteLock>> GetAllForms() {
+            auto& forms = TestGame::forms();
+            return {&forms.by_id, forms.lock};
+        }
+    };
+
+    struct TESFile {
+        std::string fileName;
+        std::uint8_t compileIndex = 0;
+        std::uint16_t smallFileCompileIndex = 0;
+        bool light = false;
+
+        [[nodiscard]] std::string_view GetFilename() const { return fileName; }
+        [[nodiscard]] bool IsLight() const { return light; }
+    };
+
+    struct TESFileCollection {
+        BSTArray<TESFile*> files;
+        BSTArray<TESFile*> smallFiles;
+    };
+
+    struct TESDataHandler {
+        TESFileCollection compiledFileCollection;
+
+        static TESDataHandler* GetSingleton() {
+            static TESDataHandler handler;
+            return &handler;
+        }
+
+        FormID LookupFormID(const FormID a_localID, const std::string_view a_modName) const {
+            for (const auto file : compiledFileCollection.files) {
+                if (file->fileName == a_modName) return (FormID{file->compileIndex} << 24) | (a_localID & 0xFFFFFF);
+            }
+            for (const auto file : compiledFileCollection.smallFiles) {
+                if (file->fileName == a_modName) {
+                    return 0xFE000000 | (FormID{file->smallFileCompileIndex} << 12) | (a_localID & 0xFFF);
+                }
+            }
+            return 0;
+        }
+    };
+}
+
+namespace SKSE {
+    struct MessagingInterface {
+        enum : std::uint32_t {
+            kPostLoad,
+            kPostPostLoad,
+            kPreLoadGame,
+            kPostLoadGame,
+            kSaveGame,
+            kDeleteGame,
+            kInputLoaded,
+            kNewGame,
+            kDataLoaded
+        };
+
+        struct Message {
+            std::uint32_t type;
+            std::uint32_t dataLen;
+            void* data;
+            const char* sender;
+        };
+    };
+
+    // Records are one in-memory byte stream; calls counts the interface calls made
+    class SerializationInterface {
+    public:
+        std::string data;
+        std::size_t position = 0;
+        std::size_t calls = 0;
+
+        bool WriteRecordData(const void* a_buf, const std::uint32_t a_length) {
+            ++calls;
+            data.append(static_cast<const char*>(a_buf), a_length);
+            return true;
+        }
+
+        template <class T>
+        bool WriteRecordData(const T& a_val) {
+            return WriteRecordData(std::addressof(a_val), sizeof(T));
+        }
+
+        std::uint32_t ReadRecordData(void* a_buf, std::uint32_t a_length) {
+            ++calls;
+            a_length = static_cast<std::uint32_t>(std::min<std::size_t>(a_length, data.size() - position));
+            std::memcpy(a_buf, data.data() + position, a_length);
+            position += a_length;
+            return a_length;
+        }
+
+        template <class T>
+        bool ReadRecordData(T& a_val) {
+            return ReadRecordData(std::addressof(a_val), sizeof(T)) == sizeof(T);
+        }
+    };
+}
+
+namespace TestGame {
+    inline RE::TESForm& AddForm(const RE::FormID a_formID, const std::string_view a_editorID = {}) {
+        auto& forms = TestGame::forms();
+        auto& form = forms.storage.emplace_back();
+        form.formID = a_formID;
+        form.editorID = a_editorID;
+        forms.by_id[a_formID] = &form;
+        if (!a_editorID.empty()) forms.by_editor_id[form.editorID] = &form;
+        return form;
+    }
+
+    // Regular plugins get compile indices in call order, light plugins their own
+    inline void SetLoadOrder(const std::vector<std::string>& a_plugins, const std::vector<std::string>& a_light = {}) {
+        static std::deque<RE::TESFile> files;
+        auto& collection = RE::TESDataHandler::GetSingleton()->compiledFileCollection;
+        files.clear();
+        collection.files.clear();
+        collection.smallFiles.clear();
+        for (std::size_t i = 0; i < a_plugins.size(); ++i) {
+            collection.files.push_back(&files.emplace_back(a_plugins[i], static_cast<std::uint8_t>(i)));
+        }
+        for (std::size_t i = 0; i < a_light.size(); ++i) {
+            collection.smallFiles.push_back(&files.emplace_back(a_light[i], 0xFE, static_cast<std::uint16_t>(i), true));
+        }
+    }
+
+    inline void Reset() {
+        auto& forms = TestGame::forms();
+        forms.by_editor_id.clear();
+        forms.by_id.clear();
+        forms.storage.clear();
+        SetLoadOrder({});
+    }
+}